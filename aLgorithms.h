@@ -12,14 +12,137 @@
 #include <set>
 #include <numeric>
 #include <stack>
+#include <climits>
+#include <cstdint>
+#include <bit>
+#include <cmath>
+#include "heaps.h"
+#include "disjointSet.h"
+#include "parallel.h"
+#include "flowNetwork.h"
+#include "perfCounters.h"
+#include "workspace.h"
+#include "simd.h"
+#include <atomic>
+#include <barrier>
+#include <deque>
+#include <span>
+#include <memory>
+#include <tuple>
 
-enum class GraphRepresentation { LIST, MATRIX };
+enum class GraphRepresentation { LIST, MATRIX, CSR };
 enum class GraphAlgorithmType {
     PRIM,
     KRUSKAL,
     DIJKSTRA,
     FORD_BELLMAN,
-    FORD_FULKERSON
+    FORD_FULKERSON,
+    DINIC,
+    PUSH_RELABEL,
+    BORUVKA
+};
+
+// Sposob wyboru kolejnego wierzcholka w algorytmie Prima
+enum class PrimQueue {
+    AUTO,           // ARRAY dla grafow gestych, QUAD_HEAP dla rzadkich
+    ARRAY,          // skan tablicy kluczy, O(V^2)
+    BINARY_HEAP,
+    QUAD_HEAP,
+    PAIRING_HEAP
+};
+
+// Wariant algorytmu Kruskala
+enum class KruskalVariant {
+    SORT,           // sortowanie calej listy krawedzi w jednym watku
+    PARALLEL_SORT,  // sortowanie rownolegle
+    FILTER          // Filter-Kruskal: podzial wzgledem pivota, odrzucanie krawedzi wewnatrz skladowych
+};
+
+// Kolejka priorytetowa w algorytmie Dijkstry; DIAL i RADIX_HEAP wymagaja nieujemnych wag calkowitych
+enum class DijkstraEngine {
+    BINARY_HEAP,    // std::priority_queue z leniwym usuwaniem
+    DIAL,           // cykliczna kolejka kubelkowa, O(E + V * C); dla C > DIAL_MAX_WEIGHT kopiec radix
+    RADIX_HEAP,     // kopiec radix, O(E + V log C)
+    DELTA_STEPPING  // rownolegly delta-stepping (wszystkie rdzenie, delta dobierana automatycznie)
+};
+
+// Wariant algorytmu Bellmana-Forda
+enum class BellmanFordEngine {
+    PASSES,     // przebiegi po wszystkich lukach, przerywane gdy przebieg niczego nie zmieni
+    SPFA,       // kolejka wierzcholkow z heurystykami SLF i LLL
+    PARALLEL    // przebiegi Jacobiego, luki wchodzace podzielone miedzy watki wedlug wierzcholka docelowego
+};
+
+// Wyszukiwanie sciezki miedzy dwoma wierzcholkami (--file, problem 1, Dijkstra)
+enum class PathSearch {
+    FULL,           // pelne drzewo najkrotszych sciezek silnikiem z --dijkstra
+    EARLY_EXIT,     // Dijkstra przerywany po rozliczeniu celu
+    BIDIRECTIONAL,  // jednoczesnie od startu po grafie i od celu po grafie odwrotnym
+    ALT             // A* z dolnym ograniczeniem z punktow orientacyjnych (nierownosc trojkata)
+};
+
+// Wynik zapytania punkt-punkt; cost == INT_MAX i pusta sciezka, gdy cel jest nieosiagalny
+struct PathResult {
+    int cost = std::numeric_limits<int>::max();
+    std::vector<int> path;
+    int settled = 0;  // liczba rozwinietych wierzcholkow - miara pracy zapytania
+};
+
+struct BellmanFordResult {
+    std::vector<int> dist;
+    std::vector<int> prev;
+    bool negativeCycle = false;
+    std::vector<int> cycle;  // wierzcholki ujemnego cyklu w kolejnosci lukow, pierwszy powtorzony na koncu
+};
+
+// Bufory Dijkstry wielokrotnego uzytku (np. jeden na watek w trybie wsadowym). Przed kolejnym przebiegiem
+// przywracane sa tylko wierzcholki odwiedzone w poprzednim, wiec reset kosztuje tyle, ile praca, a nie O(V).
+struct ShortestPathWorkspace {
+    std::vector<int> dist, prev;
+    std::vector<int> touched;
+    std::vector<std::pair<int, int>> heap;   // (odleglosc, wierzcholek), leniwe usuwanie
+    std::vector<char> pending;               // cele, ktore nie zostaly jeszcze rozliczone
+
+    void reset(int n) {
+        if (dist.size() != static_cast<size_t>(n)) {
+            dist.assign(n, std::numeric_limits<int>::max());
+            prev.assign(n, -1);
+            pending.assign(n, 0);
+        }
+        else {
+            for (int v : touched) {
+                dist[v] = std::numeric_limits<int>::max();
+                prev[v] = -1;
+            }
+        }
+        touched.clear();
+        heap.clear();
+    }
+};
+
+// Odleglosci od i do kilku punktow orientacyjnych L (ALT). Dla kazdego L: d(v, t) >= d(L, t) - d(L, v)
+// oraz d(v, t) >= d(v, L) - d(t, L); najwieksze z tych ograniczen jest dopuszczalna heurystyka A*.
+// Tablice ulozone wierzcholkami (v * count + i), aby ograniczenie dla v czytalo jeden ciagly fragment.
+struct Landmarks {
+    int count = 0;
+    std::vector<int> vertices;
+    std::vector<int> from;  // d(L_i, v)
+    std::vector<int> to;    // d(v, L_i)
+
+    int lowerBound(int v, int t) const {
+        const int INF = std::numeric_limits<int>::max();
+        const int* fv = from.data() + static_cast<size_t>(v) * count;
+        const int* ft = from.data() + static_cast<size_t>(t) * count;
+        const int* tv = to.data() + static_cast<size_t>(v) * count;
+        const int* tt = to.data() + static_cast<size_t>(t) * count;
+        int bound = 0;
+        for (int i = 0; i < count; ++i) {
+            // brak ograniczenia, gdy ktoras z odleglosci jest nieskonczona
+            if (fv[i] != INF && ft[i] != INF) bound = std::max(bound, ft[i] - fv[i]);
+            if (tv[i] != INF && tt[i] != INF) bound = std::max(bound, tv[i] - tt[i]);
+        }
+        return bound;
+    }
 };
 
 struct Edge {
@@ -29,18 +152,92 @@ struct Edge {
     }
 };
 
+struct MaxFlowResult {
+    long long flow = 0;
+    std::vector<char> sourceSide;  // 1 dla wierzcholkow po stronie zrodla w przekroju minimalnym
+    std::vector<Edge> cutEdges;    // krawedzie wejsciowe przecinajace przekroj (od strony zrodla do ujscia)
+};
+
+// Bufory algorytmow wielokrotnego uzytku (np. w petli pomiarowej lub przy obsludze wielu zapytan): po pierwszym
+// wywolaniu dla danego rozmiaru grafu kolejne nie alokuja pamieci. Wynik zostaje w workspace do nastepnego
+// wywolania: mst (Prim, Kruskal), paths (Dijkstra), bellmanFord.
+struct AlgorithmWorkspace {
+    // Prim: klucze, poprzednicy i znaczniki drzewa z resetem przez epoke, kopiec (klucz, wierzcholek)
+    StampedArray<int> key, parent;
+    StampedArray<char> inTree;
+    std::vector<std::pair<int, int>> heap;
+    // Kruskal
+    std::vector<Edge> edges;
+    DisjointSet sets{ 0 };
+    std::vector<Edge> mst;
+
+    ShortestPathWorkspace paths;
+    BellmanFordResult bellmanFord;
+
+    // Ford-Fulkerson: przepustowosci residualne V x V wierszami, poprzednicy BFS i kolejka
+    std::vector<int> residual;
+    StampedArray<int> bfsParent;
+    std::vector<int> queue;
+};
+
+
+
+// Macierz sasiedztwa V x V: bitmapa istnienia krawedzi (64 kolumny na slowo) i tablica wag.
+// Przy krawedziach wielokrotnych pamietana jest najmniejsza waga.
+struct AdjacencyMatrix {
+    int vertices = 0;
+    int wordsPerRow = 0;
+    std::vector<uint64_t> bits;
+    std::vector<int> weights;
+
+    void resize(int n) {
+        vertices = n;
+        wordsPerRow = (n + 63) / 64;
+        bits.assign(static_cast<size_t>(n) * wordsPerRow, 0);
+        weights.assign(static_cast<size_t>(n) * n, 0);
+    }
+
+    bool has(int u, int v) const {
+        return (bits[static_cast<size_t>(u) * wordsPerRow + v / 64] >> (v % 64)) & 1;
+    }
+
+    int weight(int u, int v) const {
+        return weights[static_cast<size_t>(u) * vertices + v];
+    }
+
+    void set(int u, int v, int w) {
+        uint64_t& word = bits[static_cast<size_t>(u) * wordsPerRow + v / 64];
+        uint64_t mask = uint64_t{ 1 } << (v % 64);
+        int& cell = weights[static_cast<size_t>(u) * vertices + v];
+        if (!(word & mask) || w < cell) cell = w;
+        word |= mask;
+    }
 
+    // fn(v, waga) dla kazdego ustawionego bitu w wierszu u
+    template <typename Fn>
+    void forEachInRow(int u, Fn&& fn) const {
+        const uint64_t* row = &bits[static_cast<size_t>(u) * wordsPerRow];
+        const int* rowWeights = &weights[static_cast<size_t>(u) * vertices];
+        for (int wi = 0; wi < wordsPerRow; ++wi) {
+            for (uint64_t word = row[wi]; word; word &= word - 1) {
+                int v = wi * 64 + std::countr_zero(word);
+                fn(v, rowWeights[v]);
+            }
+        }
+    }
+};
 
 struct Graph {
     int vertices;
     bool directed;
     GraphRepresentation representation;
     std::vector<std::vector<std::pair<int, int>>> adjList;
-    std::vector<std::vector<int>> incidenceMatrix;
+    AdjacencyMatrix matrix;
     std::vector<Edge> edges;
 
     Graph(int v, bool dir, GraphRepresentation repr = GraphRepresentation::LIST)
         : vertices(v), directed(dir), representation(repr), adjList(v) {
+        if (representation == GraphRepresentation::MATRIX) matrix.resize(vertices);
     }
 
     void addEdge(int u, int v, int w) {
@@ -48,52 +245,547 @@ struct Graph {
         if (!directed) adjList[v].emplace_back(u, w);
         edges.push_back({ u, v, w });
         if (representation == GraphRepresentation::MATRIX) {
-            if (incidenceMatrix.empty()) incidenceMatrix.resize(vertices);
-            for (std::vector<int>& row : incidenceMatrix) row.push_back(0);
-            int idx = static_cast<int>(edges.size()) - 1;
-            incidenceMatrix[u][idx] = -1;
-            incidenceMatrix[v][idx] = 1;
+            matrix.set(u, v, w);
+            if (!directed) matrix.set(v, u, w);
+        }
+    }
+
+    // Wstawia cala liste krawedzi naraz: najpierw zliczanie stopni, potem wypelnianie
+    // wierszy o dokladnie zarezerwowanym rozmiarze. Kolejnosc sasiadow jak przy kolejnych addEdge.
+    void setEdges(std::vector<Edge>&& list) {
+        std::vector<int> degree(vertices, 0);
+        for (const Edge& e : list) {
+            ++degree[e.from];
+            if (!directed) ++degree[e.to];
+        }
+        for (int u = 0; u < vertices; ++u) {
+            adjList[u].clear();
+            adjList[u].reserve(degree[u]);
+        }
+        for (const Edge& e : list) {
+            adjList[e.from].emplace_back(e.to, e.weight);
+            if (!directed) adjList[e.to].emplace_back(e.from, e.weight);
+            if (representation == GraphRepresentation::MATRIX) {
+                matrix.set(e.from, e.to, e.weight);
+                if (!directed) matrix.set(e.to, e.from, e.weight);
+            }
+        }
+        edges = std::move(list);
+    }
+
+    // Wartosc macierzy incydencji wyliczana z listy krawedzi - macierz nie jest przechowywana
+    int incidence(int u, int edgeIdx) const {
+        const Edge& e = edges[edgeIdx];
+        if (e.to == u) return 1;
+        return e.from == u ? -1 : 0;
+    }
+};
+
+// Zamrozona postac grafu (CSR): sasiedzi wierzcholka u leza w targets/weights
+// pod indeksami [offsets[u], offsets[u + 1]). Budowana raz, po wczytaniu lub wygenerowaniu grafu.
+// Tablice sa widokami tylko do odczytu; storage utrzymuje przy zyciu ich wlasciciela -
+// wlasne wektory albo zmapowany plik snapshotu (wtedy graf nie jest kopiowany do pamieci).
+struct CSRGraph {
+    int vertices;
+    bool directed;
+    std::span<const int> offsets;
+    std::span<const int> targets;
+    std::span<const int> weights;
+    std::shared_ptr<const void> storage;
+
+    explicit CSRGraph(const Graph& g) : CSRGraph(g.vertices, g.directed, g.edges) {}
+
+    // Budowa wprost z listy krawedzi (np. z generatora lub snapshotu), bez posredniego Graph
+    CSRGraph(int v, bool dir, std::span<const Edge> edges) : vertices(v), directed(dir) {
+        std::shared_ptr<Arrays> arrays = std::make_shared<Arrays>();
+        std::vector<int>& off = arrays->offsets;
+        off.assign(vertices + 1, 0);
+        for (const Edge& e : edges) {
+            ++off[e.from + 1];
+            if (!directed) ++off[e.to + 1];
+        }
+        for (int u = 0; u < vertices; ++u) off[u + 1] += off[u];
+
+        arrays->targets.resize(off[vertices]);
+        arrays->weights.resize(off[vertices]);
+        std::vector<int> pos(off.begin(), off.end() - 1);
+        for (const Edge& e : edges) {
+            arrays->targets[pos[e.from]] = e.to;
+            arrays->weights[pos[e.from]++] = e.weight;
+            if (!directed) {
+                arrays->targets[pos[e.to]] = e.from;
+                arrays->weights[pos[e.to]++] = e.weight;
+            }
+        }
+        adopt(std::move(arrays));
+    }
+
+    // Widok na tablice lezace w pamieci nalezacej do owner (np. zmapowany plik)
+    CSRGraph(int v, bool dir, std::span<const int> off, std::span<const int> tgt, std::span<const int> w, std::shared_ptr<const void> owner)
+        : vertices(v), directed(dir), offsets(off), targets(tgt), weights(w), storage(std::move(owner)) {
+    }
+
+    CSRGraph() : vertices(0), directed(true) {
+        adopt(std::make_shared<Arrays>(Arrays{ std::vector<int>(1, 0), {}, {} }));
+    }
+
+    int arcCount() const { return offsets[vertices]; }
+
+    // Graf z odwroconymi lukami: sasiedzi u to wierzcholki, z ktorych prowadzi luk do u
+    CSRGraph reversed() const {
+        CSRGraph r;
+        r.vertices = vertices;
+        r.directed = directed;
+        std::shared_ptr<Arrays> arrays = std::make_shared<Arrays>();
+        std::vector<int>& off = arrays->offsets;
+        off.assign(vertices + 1, 0);
+        for (int a = 0; a < arcCount(); ++a) ++off[targets[a] + 1];
+        for (int u = 0; u < vertices; ++u) off[u + 1] += off[u];
+        arrays->targets.resize(arcCount());
+        arrays->weights.resize(arcCount());
+        std::vector<int> pos(off.begin(), off.end() - 1);
+        for (int u = 0; u < vertices; ++u) {
+            for (int a = offsets[u]; a < offsets[u + 1]; ++a) {
+                int slot = pos[targets[a]]++;
+                arrays->targets[slot] = u;
+                arrays->weights[slot] = weights[a];
+            }
         }
+        r.adopt(std::move(arrays));
+        return r;
+    }
+
+private:
+    struct Arrays {
+        std::vector<int> offsets, targets, weights;
+    };
+
+    void adopt(std::shared_ptr<Arrays> arrays) {
+        offsets = arrays->offsets;
+        targets = arrays->targets;
+        weights = arrays->weights;
+        storage = std::move(arrays);
     }
 };
 
+// Jednolity dostep do sasiadow dla obu postaci grafu: fn(v, waga)
+template <typename Fn>
+void forEachNeighbor(const Graph& g, int u, Fn&& fn) {
+    for (const std::pair<int, int>& p : g.adjList[u]) fn(p.first, p.second);
+}
+
+template <typename Fn>
+void forEachNeighbor(const CSRGraph& g, int u, Fn&& fn) {
+    for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) fn(g.targets[i], g.weights[i]);
+}
+
+template <typename Fn>
+void forEachNeighbor(const AdjacencyMatrix& m, int u, Fn&& fn) {
+    m.forEachInRow(u, fn);
+}
+
+// Lista krawedzi w kolejnosci wejscia (Graph) lub odtworzona z tablic CSR
+const std::vector<Edge>& edgeList(const Graph& g) {
+    return g.edges;
+}
+
+// Wersje zapisujace do istniejacego bufora (bez alokacji, gdy pojemnosc wystarcza)
+void edgeListInto(const Graph& g, std::vector<Edge>& out) {
+    out.assign(g.edges.begin(), g.edges.end());
+}
+
+void edgeListInto(const CSRGraph& g, std::vector<Edge>& out) {
+    out.clear();
+    out.reserve(g.directed ? g.arcCount() : g.arcCount() / 2);
+    for (int u = 0; u < g.vertices; ++u) {
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            int v = g.targets[i];
+            // krawedz nieskierowana wystepuje w CSR dwukrotnie - bierzemy jedna kopie
+            if (g.directed || u < v) out.push_back({ u, v, g.weights[i] });
+        }
+    }
+}
+
+std::vector<Edge> edgeList(const CSRGraph& g) {
+    std::vector<Edge> result;
+    edgeListInto(g, result);
+    return result;
+}
+
+// Najmniejsza i najwieksza waga krawedzi ({0, 0} dla grafu bez krawedzi)
+std::pair<int, int> weightRange(const Graph& g) {
+    if (g.edges.empty()) return { 0, 0 };
+    auto range = std::minmax_element(g.edges.begin(), g.edges.end(),
+        [](const Edge& a, const Edge& b) { return a.weight < b.weight; });
+    return { range.first->weight, range.second->weight };
+}
+
+std::pair<int, int> weightRange(const CSRGraph& g) {
+    if (g.weights.empty()) return { 0, 0 };
+    auto range = std::minmax_element(g.weights.begin(), g.weights.end());
+    return { *range.first, *range.second };
+}
+
 class GraphAlgorithms {
 public:
-    static std::vector<Edge> primMST(const Graph& g);
-    static std::vector<Edge> kruskalMST(const Graph& g);
-    static std::pair<std::vector<int>, std::vector<int>> dijkstra(const Graph& g, int start);
+    static std::vector<Edge> primMST(const Graph& g, PrimQueue queue = PrimQueue::AUTO);
+    static std::vector<Edge> kruskalMST(const Graph& g, KruskalVariant variant = KruskalVariant::SORT, unsigned threads = 1);
+    static std::pair<std::vector<int>, std::vector<int>> dijkstra(const Graph& g, int start, DijkstraEngine engine = DijkstraEngine::BINARY_HEAP);
     static std::pair<std::vector<int>, std::vector<int>> fordBellman(const Graph& g, int start);
     static int fordFulkerson(Graph& g, int source, int sink);
+
+    static std::vector<Edge> primMST(const CSRGraph& g, PrimQueue queue = PrimQueue::AUTO);
+    static PrimQueue choosePrimQueue(int vertices, long long edges);
+    static std::vector<Edge> kruskalMST(const CSRGraph& g, KruskalVariant variant = KruskalVariant::SORT, unsigned threads = 1);
+    // Rownolegly Boruvka; ta sama waga drzewa (lasu) co kruskalMST, krawedzie w kolejnosci rosnacych wag
+    static std::vector<Edge> boruvkaMST(const Graph& g, unsigned threads = defaultThreadCount());
+    static std::vector<Edge> boruvkaMST(const CSRGraph& g, unsigned threads = defaultThreadCount());
+    static std::pair<std::vector<int>, std::vector<int>> dijkstra(const CSRGraph& g, int start, DijkstraEngine engine = DijkstraEngine::BINARY_HEAP);
+    // delta = 0 - dobor automatyczny (maksymalna waga / sredni stopien)
+    static std::pair<std::vector<int>, std::vector<int>> deltaStepping(const Graph& g, int start, int delta = 0, unsigned threads = defaultThreadCount());
+    static std::pair<std::vector<int>, std::vector<int>> deltaStepping(const CSRGraph& g, int start, int delta = 0, unsigned threads = defaultThreadCount());
+    static std::pair<std::vector<int>, std::vector<int>> fordBellman(const CSRGraph& g, int start);
+    static int fordFulkerson(const CSRGraph& g, int source, int sink);
+
+    static BellmanFordResult bellmanFord(const Graph& g, int start, BellmanFordEngine engine = BellmanFordEngine::PASSES, unsigned threads = 1);
+    static BellmanFordResult bellmanFord(const CSRGraph& g, int start, BellmanFordEngine engine = BellmanFordEngine::PASSES, unsigned threads = 1);
+    static MaxFlowResult dinic(const Graph& g, int source, int sink);
+    static MaxFlowResult dinic(const CSRGraph& g, int source, int sink);
+    static MaxFlowResult pushRelabel(const Graph& g, int source, int sink);
+    static MaxFlowResult pushRelabel(const CSRGraph& g, int source, int sink);
+
+    // Dijkstra do buforow ws; konczy sie, gdy wszystkie targets sa rozliczone (puste targets - pelne drzewo).
+    // Wierzcholki nieodwiedzone maja w ws.dist INT_MAX. G: Graph, CSRGraph albo AdjacencyMatrix.
+    template <typename G>
+    static void dijkstraInto(const G& g, int start, const std::vector<int>& targets, ShortestPathWorkspace& ws);
+
+    // Zapytania punkt-punkt (wagi nieujemne). heuristic(v) - dolne ograniczenie d(v, target); przy zerowej
+    // heurystyce A* jest Dijkstra przerwanym po rozliczeniu celu. reverse - graf z odwroconymi lukami
+    // (dla grafu nieskierowanego sam graf), budowany raz dla wielu zapytan.
+    template <typename G, typename H>
+    static PathResult aStar(const G& g, int source, int target, H&& heuristic);
+    template <typename G, typename R>
+    static PathResult bidirectionalDijkstra(const G& g, const R& reverse, int source, int target);
+    // Punkty orientacyjne wybierane zachlannie: kazdy kolejny jest najdalej od juz wybranych
+    template <typename G, typename R>
+    static Landmarks selectLandmarks(const G& g, const R& reverse, int count);
+
+    // Warianty korzystajace z AlgorithmWorkspace; zwracaja referencje do wyniku w ws. Prim - kopiec binarny
+    // z leniwym usuwaniem, Bellman-Ford - przebiegi po lukach (PASSES).
+    static const std::vector<Edge>& primMST(const Graph& g, AlgorithmWorkspace& ws);
+    static const std::vector<Edge>& primMST(const CSRGraph& g, AlgorithmWorkspace& ws);
+    static const std::vector<Edge>& kruskalMST(const Graph& g, AlgorithmWorkspace& ws, KruskalVariant variant = KruskalVariant::SORT, unsigned threads = 1);
+    static const std::vector<Edge>& kruskalMST(const CSRGraph& g, AlgorithmWorkspace& ws, KruskalVariant variant = KruskalVariant::SORT, unsigned threads = 1);
+    static const ShortestPathWorkspace& dijkstra(const Graph& g, int start, AlgorithmWorkspace& ws);
+    static const ShortestPathWorkspace& dijkstra(const CSRGraph& g, int start, AlgorithmWorkspace& ws);
+    static const BellmanFordResult& bellmanFord(const Graph& g, int start, AlgorithmWorkspace& ws);
+    static const BellmanFordResult& bellmanFord(const CSRGraph& g, int start, AlgorithmWorkspace& ws);
+    static int fordFulkerson(const Graph& g, int source, int sink, AlgorithmWorkspace& ws);
+    static int fordFulkerson(const CSRGraph& g, int source, int sink, AlgorithmWorkspace& ws);
+
+    // Dowolny cykl w grafie poprzednikow (v -> prev[v]) w kolejnosci lukow; pusty, gdy go nie ma
+    static std::vector<int> predecessorCycle(const std::vector<int>& prev);
+
+    // Przebiegi Bellmana-Forda nad dowolnym zrodlem lukow (np. plikiem czytanym sekwencyjnie w externalBellmanFord)
+    template <typename Scan>
+    static BellmanFordResult bellmanFordPasses(int n, int start, Scan scanArcs);
+
+private:
+    template <typename G>
+    static std::vector<Edge> primImpl(const G& g);
+    template <typename G>
+    static std::vector<Edge> primImpl(const G& g, PrimQueue queue);
+    template <typename Heap, typename G>
+    static std::vector<Edge> primHeapImpl(const G& g);
+    template <typename G>
+    static void primLazyImpl(const G& g, AlgorithmWorkspace& ws);
+    template <typename G>
+    static void kruskalImpl(const G& g, KruskalVariant variant, unsigned threads, AlgorithmWorkspace& ws);
+    static void filterKruskal(std::vector<Edge>& edges, size_t lo, size_t hi, DisjointSet& sets,
+        std::vector<Edge>& mstEdges, size_t target, size_t baseSize, unsigned threads);
+    template <typename G>
+    static std::vector<Edge> boruvkaImpl(const G& g, unsigned threads);
+    static std::vector<Edge> boruvkaRounds(int vertices, const std::vector<Edge>& edges, unsigned threads);
+    template <typename G>
+    static std::pair<std::vector<int>, std::vector<int>> dijkstraImpl(const G& g, int start);
+    static std::pair<std::vector<int>, std::vector<int>> dijkstraDense(const AdjacencyMatrix& m, int start);
+    template <typename G>
+    static std::pair<std::vector<int>, std::vector<int>> dijkstraBucketed(const G& g, int start, DijkstraEngine engine, std::pair<int, int> weights);
+    template <typename Queue, typename G>
+    static std::pair<std::vector<int>, std::vector<int>> dijkstraMonotoneImpl(const G& g, int start, Queue& queue);
+    template <typename Scan>
+    static void bellmanFordPasses(int n, int start, Scan scanArcs, BellmanFordResult& r);
+    template <typename G>
+    static BellmanFordResult bellmanFordAdjacency(const G& g, int start);
+    static void bellmanFordMatrix(const AdjacencyMatrix& m, int start, BellmanFordResult& r);
+    template <typename G>
+    static BellmanFordResult spfa(const G& g, int start);
+    static BellmanFordResult bellmanFordParallel(const CSRGraph& incoming, int start, unsigned threads);
+    static long long dinicFlow(FlowNetwork& net, int source, int sink);
+    static long long pushRelabelFlow(FlowNetwork& net, int source, int sink);
+    static void globalRelabel(const FlowNetwork& net, int sink, std::vector<int>& height);
+    static MaxFlowResult minCut(const Graph& g, long long flow, std::vector<char> sourceSide);
+    template <typename G>
+    static int fordFulkersonImpl(const G& g, int source, int sink, AlgorithmWorkspace& ws);
 };
 
+// Dla reprezentacji MATRIX algorytmy iteruja macierz sasiedztwa zamiast listy
+std::vector<Edge> GraphAlgorithms::primMST(const Graph& g, PrimQueue queue) {
+    if (queue == PrimQueue::AUTO) queue = choosePrimQueue(g.vertices, static_cast<long long>(g.edges.size()));
+    if (g.representation == GraphRepresentation::MATRIX) return primImpl(g.matrix, queue);
+    return primImpl(g, queue);
+}
+std::vector<Edge> GraphAlgorithms::primMST(const CSRGraph& g, PrimQueue queue) {
+    if (queue == PrimQueue::AUTO) queue = choosePrimQueue(g.vertices, g.directed ? g.arcCount() : g.arcCount() / 2);
+    return primImpl(g, queue);
+}
+std::vector<Edge> GraphAlgorithms::kruskalMST(const Graph& g, KruskalVariant variant, unsigned threads) {
+    AlgorithmWorkspace ws;
+    kruskalImpl(g, variant, threads, ws);
+    return std::move(ws.mst);
+}
+std::vector<Edge> GraphAlgorithms::kruskalMST(const CSRGraph& g, KruskalVariant variant, unsigned threads) {
+    AlgorithmWorkspace ws;
+    kruskalImpl(g, variant, threads, ws);
+    return std::move(ws.mst);
+}
+std::vector<Edge> GraphAlgorithms::boruvkaMST(const Graph& g, unsigned threads) {
+    return boruvkaImpl(g, threads);
+}
+std::vector<Edge> GraphAlgorithms::boruvkaMST(const CSRGraph& g, unsigned threads) {
+    return boruvkaImpl(g, threads);
+}
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstra(const Graph& g, int start, DijkstraEngine engine) {
+    if (engine == DijkstraEngine::DELTA_STEPPING) return deltaStepping(g, start);
+    if (g.representation == GraphRepresentation::MATRIX) {
+        if (engine == DijkstraEngine::BINARY_HEAP) return dijkstraDense(g.matrix, start);
+        return dijkstraBucketed(g.matrix, start, engine, weightRange(g));
+    }
+    if (engine == DijkstraEngine::BINARY_HEAP) return dijkstraImpl(g, start);
+    return dijkstraBucketed(g, start, engine, weightRange(g));
+}
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstra(const CSRGraph& g, int start, DijkstraEngine engine) {
+    if (engine == DijkstraEngine::DELTA_STEPPING) return deltaStepping(g, start);
+    if (engine == DijkstraEngine::BINARY_HEAP) return dijkstraImpl(g, start);
+    return dijkstraBucketed(g, start, engine, weightRange(g));
+}
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::fordBellman(const CSRGraph& g, int start) {
+    BellmanFordResult r = bellmanFord(g, start);
+    return { std::move(r.dist), std::move(r.prev) };
+}
+
+BellmanFordResult GraphAlgorithms::bellmanFord(const Graph& g, int start, BellmanFordEngine engine, unsigned threads) {
+    if (engine == BellmanFordEngine::PARALLEL) return bellmanFordParallel(CSRGraph(g).reversed(), start, threads);
+    if (g.representation == GraphRepresentation::MATRIX) {
+        if (engine == BellmanFordEngine::SPFA) return spfa(g.matrix, start);
+        BellmanFordResult r;
+        bellmanFordMatrix(g.matrix, start, r);
+        return r;
+    }
+    if (engine == BellmanFordEngine::SPFA) return spfa(g, start);
+    return bellmanFordPasses(g.vertices, start, [&g](const std::vector<int>&, auto&& relax) {
+        for (const Edge& e : g.edges) relax(e.from, e.to, e.weight);
+    });
+}
+
+BellmanFordResult GraphAlgorithms::bellmanFord(const CSRGraph& g, int start, BellmanFordEngine engine, unsigned threads) {
+    switch (engine) {
+    case BellmanFordEngine::SPFA: return spfa(g, start);
+    case BellmanFordEngine::PARALLEL: return bellmanFordParallel(g.reversed(), start, threads);
+    default: return bellmanFordAdjacency(g, start);
+    }
+}
+int GraphAlgorithms::fordFulkerson(Graph& g, int source, int sink) {
+    AlgorithmWorkspace ws;
+    return fordFulkersonImpl(g, source, sink, ws);
+}
+int GraphAlgorithms::fordFulkerson(const CSRGraph& g, int source, int sink) {
+    AlgorithmWorkspace ws;
+    return fordFulkersonImpl(g, source, sink, ws);
+}
+
+const std::vector<Edge>& GraphAlgorithms::primMST(const Graph& g, AlgorithmWorkspace& ws) {
+    if (g.representation == GraphRepresentation::MATRIX) primLazyImpl(g.matrix, ws);
+    else primLazyImpl(g, ws);
+    return ws.mst;
+}
+const std::vector<Edge>& GraphAlgorithms::primMST(const CSRGraph& g, AlgorithmWorkspace& ws) {
+    primLazyImpl(g, ws);
+    return ws.mst;
+}
+const std::vector<Edge>& GraphAlgorithms::kruskalMST(const Graph& g, AlgorithmWorkspace& ws, KruskalVariant variant, unsigned threads) {
+    kruskalImpl(g, variant, threads, ws);
+    return ws.mst;
+}
+const std::vector<Edge>& GraphAlgorithms::kruskalMST(const CSRGraph& g, AlgorithmWorkspace& ws, KruskalVariant variant, unsigned threads) {
+    kruskalImpl(g, variant, threads, ws);
+    return ws.mst;
+}
+const ShortestPathWorkspace& GraphAlgorithms::dijkstra(const Graph& g, int start, AlgorithmWorkspace& ws) {
+    static const std::vector<int> wholeTree;
+    if (g.representation == GraphRepresentation::MATRIX) dijkstraInto(g.matrix, start, wholeTree, ws.paths);
+    else dijkstraInto(g, start, wholeTree, ws.paths);
+    return ws.paths;
+}
+const ShortestPathWorkspace& GraphAlgorithms::dijkstra(const CSRGraph& g, int start, AlgorithmWorkspace& ws) {
+    static const std::vector<int> wholeTree;
+    dijkstraInto(g, start, wholeTree, ws.paths);
+    return ws.paths;
+}
+const BellmanFordResult& GraphAlgorithms::bellmanFord(const Graph& g, int start, AlgorithmWorkspace& ws) {
+    if (g.representation == GraphRepresentation::MATRIX) {
+        bellmanFordMatrix(g.matrix, start, ws.bellmanFord);
+        return ws.bellmanFord;
+    }
+    bellmanFordPasses(g.vertices, start, [&g](const std::vector<int>&, auto&& relax) {
+        for (const Edge& e : g.edges) relax(e.from, e.to, e.weight);
+    }, ws.bellmanFord);
+    return ws.bellmanFord;
+}
+const BellmanFordResult& GraphAlgorithms::bellmanFord(const CSRGraph& g, int start, AlgorithmWorkspace& ws) {
+    bellmanFordPasses(g.vertices, start, [&g](const std::vector<int>& dist, auto&& relax) {
+        for (int u = 0; u < g.vertices; ++u) {
+            if (dist[u] == std::numeric_limits<int>::max()) continue;
+            forEachNeighbor(g, u, [&](int v, int w) { relax(u, v, w); });
+        }
+    }, ws.bellmanFord);
+    return ws.bellmanFord;
+}
+int GraphAlgorithms::fordFulkerson(const Graph& g, int source, int sink, AlgorithmWorkspace& ws) {
+    return fordFulkersonImpl(g, source, sink, ws);
+}
+int GraphAlgorithms::fordFulkerson(const CSRGraph& g, int source, int sink, AlgorithmWorkspace& ws) {
+    return fordFulkersonImpl(g, source, sink, ws);
+}
+
+// Dla CSR krawedzie wejsciowe odtwarzane sa z lukow; siec budowana jest jako skierowana,
+// bo nieskierowany CSR zawiera juz oba kierunki kazdej krawedzi
+MaxFlowResult GraphAlgorithms::dinic(const Graph& g, int source, int sink) {
+    FlowNetwork net(g.vertices, g.directed, g.edges);
+    long long flow = dinicFlow(net, source, sink);
+    // po ostatnim BFS strona zrodla to wierzcholki osiagalne w sieci residualnej
+    std::vector<char> side(g.vertices, 0);
+    std::vector<int> stack{ source };
+    side[source] = 1;
+    while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        for (int a = net.offsets[u]; a < net.offsets[u + 1]; ++a)
+            if (net.cap[a] > 0 && !side[net.head[a]]) {
+                side[net.head[a]] = 1;
+                stack.push_back(net.head[a]);
+            }
+    }
+    return minCut(g, flow, std::move(side));
+}
+
+MaxFlowResult GraphAlgorithms::dinic(const CSRGraph& g, int source, int sink) {
+    std::vector<Edge> edges = edgeList(g);
+    if (!g.directed) {
+        for (size_t i = 0, n = edges.size(); i < n; ++i) edges.push_back({ edges[i].to, edges[i].from, edges[i].weight });
+    }
+    Graph view(g.vertices, true);
+    view.edges = std::move(edges);
+    return dinic(view, source, sink);
+}
+
+MaxFlowResult GraphAlgorithms::pushRelabel(const Graph& g, int source, int sink) {
+    FlowNetwork net(g.vertices, g.directed, g.edges);
+    long long flow = pushRelabelFlow(net, source, sink);
+    // po fazie pierwszej strona zrodla to wierzcholki, z ktorych nie da sie dojsc do ujscia
+    std::vector<int> height;
+    globalRelabel(net, sink, height);
+    std::vector<char> side(g.vertices, 0);
+    for (int v = 0; v < g.vertices; ++v) side[v] = height[v] >= g.vertices;
+    return minCut(g, flow, std::move(side));
+}
+
+MaxFlowResult GraphAlgorithms::pushRelabel(const CSRGraph& g, int source, int sink) {
+    std::vector<Edge> edges = edgeList(g);
+    if (!g.directed) {
+        for (size_t i = 0, n = edges.size(); i < n; ++i) edges.push_back({ edges[i].to, edges[i].from, edges[i].weight });
+    }
+    Graph view(g.vertices, true);
+    view.edges = std::move(edges);
+    return pushRelabel(view, source, sink);
+}
+
 // Zwraca wektor krawdzi MST
-std::vector<Edge> GraphAlgorithms::primMST(const Graph& g) {
+template <typename G>
+std::vector<Edge> GraphAlgorithms::primImpl(const G& g) {
     int n = g.vertices;
     std::vector<int> key(n, std::numeric_limits<int>::max());
-    std::vector<bool> inMST(n, false);
+    std::vector<char> inMST(n, 0);
     std::vector<int> parent(n, -1);
     key[0] = 0;
     std::vector<Edge> mstEdges;
+    const SimdKernels& kernels = simd();
 
     for (int count = 0; count < n; ++count) {
-        int u = -1;
-        for (int v = 0; v < n; ++v)
-            if (!inMST[v] && (u == -1 || key[v] < key[u]))
-                u = v;
+        // pierwszy wierzcholek spoza drzewa o najmniejszym kluczu (skan wektorowy)
+        int u = kernels.argMinUnmarked(key.data(), inMST.data(), n);
 
-        inMST[u] = true;
+        inMST[u] = 1;
 
         if (parent[u] != -1) {
             mstEdges.push_back({ parent[u], u, key[u] });
         }
 
-        for (const std::pair<int, int>& pair : g.adjList[u]) {
-            int v = pair.first;
-            int weight = pair.second;
+        forEachNeighbor(g, u, [&](int v, int weight) {
             if (!inMST[v] && weight < key[v]) {
                 key[v] = weight;
                 parent[v] = u;
             }
+        });
+    }
+    return mstEdges;
+}
+
+// Skan tablicy kosztuje O(V^2), kopiec O(E log V) - wybieramy tanszy wariant
+PrimQueue GraphAlgorithms::choosePrimQueue(int vertices, long long edges) {
+    double heapCost = static_cast<double>(edges) * std::log2(std::max(vertices, 2));
+    double arrayCost = static_cast<double>(vertices) * vertices;
+    return heapCost < arrayCost ? PrimQueue::QUAD_HEAP : PrimQueue::ARRAY;
+}
+
+template <typename G>
+std::vector<Edge> GraphAlgorithms::primImpl(const G& g, PrimQueue queue) {
+    switch (queue) {
+    case PrimQueue::BINARY_HEAP: return primHeapImpl<IndexedBinaryHeap>(g);
+    case PrimQueue::QUAD_HEAP: return primHeapImpl<IndexedQuadHeap>(g);
+    case PrimQueue::PAIRING_HEAP: return primHeapImpl<IndexedPairingHeap>(g);
+    default: return primImpl(g);
+    }
+}
+
+// Prim z kolejka priorytetowa; kolejne skladowe grafu niespojnego daja las rozpinajacy
+template <typename Heap, typename G>
+std::vector<Edge> GraphAlgorithms::primHeapImpl(const G& g) {
+    int n = g.vertices;
+    std::vector<bool> inMST(n, false);
+    std::vector<int> parent(n, -1);
+    std::vector<Edge> mstEdges;
+    Heap heap(n);
+
+    for (int root = 0; root < n; ++root) {
+        if (inMST[root]) continue;
+        heap.push(root, 0);
+        while (!heap.empty()) {
+            int u = heap.pop();
+            inMST[u] = true;
+            if (parent[u] != -1) mstEdges.push_back({ parent[u], u, heap.key(u) });
+
+            forEachNeighbor(g, u, [&](int v, int weight) {
+                if (inMST[v]) return;
+                if (!heap.contains(v)) {
+                    heap.push(v, weight);
+                    parent[v] = u;
+                }
+                else if (weight < heap.key(v)) {
+                    heap.decreaseKey(v, weight);
+                    parent[v] = u;
+                }
+            });
         }
     }
     return mstEdges;
@@ -101,31 +793,267 @@ std::vector<Edge> GraphAlgorithms::primMST(const Graph& g) {
 
 
 // Zwraca wektor krawdzi MST
-std::vector<Edge> GraphAlgorithms::kruskalMST(const Graph& g) {
-    std::vector<Edge> sortedEdges = g.edges;
-    std::sort(sortedEdges.begin(), sortedEdges.end());
-    std::vector<int> parent(g.vertices);
-    std::iota(parent.begin(), parent.end(), 0);
+template <typename G>
+void GraphAlgorithms::kruskalImpl(const G& g, KruskalVariant variant, unsigned threads, AlgorithmWorkspace& ws) {
+    std::vector<Edge>& sortedEdges = ws.edges;
+    {
+        PhaseScope phase("edge-list");
+        edgeListInto(g, sortedEdges);
+    }
+    DisjointSet& sets = ws.sets;
+    sets.reset(g.vertices);
+    std::vector<Edge>& mstEdges = ws.mst;
+    mstEdges.clear();
+    size_t target = g.vertices > 0 ? static_cast<size_t>(g.vertices) - 1 : 0;
+    mstEdges.reserve(target);
 
-    std::vector<Edge> mstEdges;
+    if (variant == KruskalVariant::FILTER) {
+        // sortowanie i laczenie zbiorow przeplataja sie w rekurencji - jedna faza
+        PhaseScope phase("filter");
+        size_t baseSize = std::max<size_t>(g.vertices, 1024);
+        filterKruskal(sortedEdges, 0, sortedEdges.size(), sets, mstEdges, target, baseSize, threads);
+        return;
+    }
 
+    {
+        PhaseScope phase("sort");
+        parallelSort(sortedEdges.begin(), sortedEdges.end(), variant == KruskalVariant::PARALLEL_SORT ? threads : 1);
+    }
+    PhaseScope phase("union-find");
     for (const Edge& e : sortedEdges) {
-        int rootU = e.from;
-        while (rootU != parent[rootU]) rootU = parent[rootU];
+        if (sets.unite(e.from, e.to)) {
+            mstEdges.push_back(e);
+            if (mstEdges.size() == target) break;
+        }
+    }
+}
 
-        int rootV = e.to;
-        while (rootV != parent[rootV]) rootV = parent[rootV];
+// Prim z kopcem binarnym (klucz, wierzcholek) i leniwym usuwaniem; wszystkie bufory w ws, tablice
+// resetowane przez epoke, wiec wywolanie kosztuje tyle, ile praca na grafie, bez wypelniania O(V)
+template <typename G>
+void GraphAlgorithms::primLazyImpl(const G& g, AlgorithmWorkspace& ws) {
+    const int n = g.vertices;
+    ws.mst.clear();
+    ws.key.reset(n, std::numeric_limits<int>::max());
+    ws.parent.reset(n, -1);
+    ws.inTree.reset(n, 0);
+    std::greater<std::pair<int, int>> later;
 
-        if (rootU != rootV) {
-            parent[rootU] = rootV;
-            mstEdges.push_back(e);
+    for (int root = 0; root < n; ++root) {
+        if (ws.inTree.get(root)) continue;
+        ws.key.set(root, 0);
+        ws.heap.clear();
+        ws.heap.emplace_back(0, root);
+        while (!ws.heap.empty()) {
+            std::pop_heap(ws.heap.begin(), ws.heap.end(), later);
+            auto [k, u] = ws.heap.back();
+            ws.heap.pop_back();
+            if (ws.inTree.get(u) || k > ws.key.get(u)) continue;
+            ws.inTree.set(u, 1);
+            if (ws.parent.get(u) != -1) ws.mst.push_back({ ws.parent.get(u), u, k });
+
+            forEachNeighbor(g, u, [&](int v, int weight) {
+                if (ws.inTree.get(v) || weight >= ws.key.get(v)) return;
+                ws.key.set(v, weight);
+                ws.parent.set(v, u);
+                ws.heap.emplace_back(weight, v);
+                std::push_heap(ws.heap.begin(), ws.heap.end(), later);
+            });
         }
     }
+}
+
+// Filter-Kruskal na zakresie [lo, hi): krawedzie lzejsze od pivota przetwarzane rekurencyjnie najpierw,
+// z ciezszych usuwane sa te, ktorych konce leza juz w jednej skladowej
+void GraphAlgorithms::filterKruskal(std::vector<Edge>& edges, size_t lo, size_t hi, DisjointSet& sets,
+    std::vector<Edge>& mstEdges, size_t target, size_t baseSize, unsigned threads) {
+    if (lo >= hi || mstEdges.size() >= target) return;
+
+    if (hi - lo <= baseSize) {
+        parallelSort(edges.begin() + lo, edges.begin() + hi, threads);
+        for (size_t i = lo; i < hi && mstEdges.size() < target; ++i)
+            if (sets.unite(edges[i].from, edges[i].to)) mstEdges.push_back(edges[i]);
+        return;
+    }
+
+    // pivot - mediana z trzech probek; podzial trojdzielny chroni przed powtarzajacymi sie wagami
+    int a = edges[lo].weight, b = edges[lo + (hi - lo) / 2].weight, c = edges[hi - 1].weight;
+    int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    auto first = edges.begin() + lo, last = edges.begin() + hi;
+    auto lightEnd = std::partition(first, last, [pivot](const Edge& e) { return e.weight < pivot; });
+    auto equalEnd = std::partition(lightEnd, last, [pivot](const Edge& e) { return e.weight == pivot; });
+    size_t mid = lightEnd - edges.begin(), heavy = equalEnd - edges.begin();
+
+    filterKruskal(edges, lo, mid, sets, mstEdges, target, baseSize, threads);
+    for (size_t i = mid; i < heavy && mstEdges.size() < target; ++i)
+        if (sets.unite(edges[i].from, edges[i].to)) mstEdges.push_back(edges[i]);
+    if (mstEdges.size() >= target) return;
+
+    // filtr: znaczniki liczone rownolegle (odczyt bez kompresji), kompaktowanie w jednym watku
+    std::vector<char> keep(hi - heavy);
+    parallelForBlocks(hi - heavy, threads, [&](size_t begin, size_t end, unsigned) {
+        for (size_t i = begin; i < end; ++i)
+            keep[i] = sets.root(edges[heavy + i].from) != sets.root(edges[heavy + i].to);
+    });
+    size_t out = heavy;
+    for (size_t i = heavy; i < hi; ++i)
+        if (keep[i - heavy]) edges[out++] = edges[i];
+
+    filterKruskal(edges, heavy, out, sets, mstEdges, target, baseSize, threads);
+}
+
+// Boruvka: w kazdej rundzie kazda skladowa wybiera najlzejsza krawedz wychodzaca, skladowe laczone sa
+// przez CAS na tablicy rodzicow, a graf sciagany - wierzcholki przenumerowane na skladowe, petle usuniete.
+// Remisy wag rozstrzyga numer luku, wiec wybrane krawedzie nie tworza cyklu. Watki pracuja na stalym
+// zestawie; etapy rundy rozdziela bariera, sumy prefiksowe liczy jej funkcja zakonczenia.
+template <typename G>
+std::vector<Edge> GraphAlgorithms::boruvkaImpl(const G& g, unsigned threads) {
+    std::vector<Edge> edges;
+    {
+        PhaseScope phase("edge-list");
+        edgeListInto(g, edges);
+    }
+    PhaseScope phase("rounds");
+    return boruvkaRounds(g.vertices, edges, threads);
+}
+
+std::vector<Edge> GraphAlgorithms::boruvkaRounds(int vertices, const std::vector<Edge>& edges, unsigned threads) {
+    struct Arc { int u, v, weight, edge; };  // konce w numeracji biezacej rundy, indeks krawedzi w edges
+    const uint64_t NONE = std::numeric_limits<uint64_t>::max();
+    // klucz (waga, numer luku) porownywany jako liczba bez znaku
+    auto key = [](int weight, size_t arc) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(weight) ^ 0x80000000u) << 32 | static_cast<uint32_t>(arc);
+    };
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max(vertices, 1))));
+
+    std::vector<Arc> arcs(edges.size()), next(edges.size());
+    parallelForBlocks(edges.size(), threads, [&](size_t begin, size_t end, unsigned) {
+        for (size_t i = begin; i < end; ++i) arcs[i] = { edges[i].from, edges[i].to, edges[i].weight, static_cast<int>(i) };
+    });
+    std::vector<std::atomic<uint64_t>> best(vertices);
+    std::vector<std::atomic<int>> parent(vertices);
+    std::vector<int> root(vertices), newId(vertices);
+    std::vector<std::vector<int>> chosen(threads);
+    std::vector<size_t> counts(threads);
+
+    auto find = [&](int x) {
+        for (int p = parent[x].load(std::memory_order_relaxed); p != x; p = parent[x].load(std::memory_order_relaxed)) {
+            int gp = parent[p].load(std::memory_order_relaxed);
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);  // polowienie sciezki
+            x = gp;
+        }
+        return x;
+    };
+    // wiekszy korzen podpinany pod mniejszy - numery rodzicow maleja, wiec CAS nie utworzy cyklu
+    auto unite = [&](int a, int b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return true;
+        }
+    };
+    auto offer = [&](int v, uint64_t candidate) {
+        uint64_t cur = best[v].load(std::memory_order_relaxed);
+        while (candidate < cur && !best[v].compare_exchange_weak(cur, candidate, std::memory_order_relaxed)) {}
+    };
+    // liczniki watkow zamieniane na przesuniecia, zwraca sume
+    auto prefix = [&]() {
+        size_t sum = 0;
+        for (size_t& c : counts) sum += std::exchange(c, sum);
+        return sum;
+    };
+
+    int k = vertices, nextK = 0;
+    size_t m = arcs.size();
+    int stage = 0;
+    bool done = m == 0;
+    auto endStage = [&]() noexcept {
+        if (stage == 3) nextK = static_cast<int>(prefix());
+        else if (stage == 5) m = prefix();
+        else if (stage == 6) {
+            arcs.swap(next);
+            k = nextK;
+            done = m == 0;
+        }
+        stage = (stage + 1) % 7;
+    };
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), endStage);
+
+    auto worker = [&](unsigned t) {
+        while (!done) {
+            const int vBegin = static_cast<int>(static_cast<long long>(k) * t / threads);
+            const int vEnd = static_cast<int>(static_cast<long long>(k) * (t + 1) / threads);
+            const size_t aBegin = m * t / threads, aEnd = m * (t + 1) / threads;
+            for (int v = vBegin; v < vEnd; ++v) {
+                best[v].store(NONE, std::memory_order_relaxed);
+                parent[v].store(v, std::memory_order_relaxed);
+            }
+            sync.arrive_and_wait();
+            // najlzejszy luk kazdej skladowej
+            for (size_t i = aBegin; i < aEnd; ++i) {
+                if (arcs[i].u == arcs[i].v) continue;  // petla z wejscia
+                uint64_t candidate = key(arcs[i].weight, i);
+                offer(arcs[i].u, candidate);
+                offer(arcs[i].v, candidate);
+            }
+            sync.arrive_and_wait();
+            for (int v = vBegin; v < vEnd; ++v) {
+                uint64_t chosenKey = best[v].load(std::memory_order_relaxed);
+                if (chosenKey == NONE) continue;
+                const Arc& a = arcs[static_cast<uint32_t>(chosenKey)];
+                // luk wybrany z obu stron laczy skladowe tylko raz
+                if (unite(a.u, a.v)) chosen[t].push_back(a.edge);
+            }
+            sync.arrive_and_wait();
+            size_t roots = 0;
+            for (int v = vBegin; v < vEnd; ++v) {
+                root[v] = find(v);
+                if (root[v] == v) ++roots;
+            }
+            counts[t] = roots;
+            sync.arrive_and_wait();
+            // sciaganie: korzenie numerowane kolejno, luki przenumerowane, petle odrzucane
+            size_t id = counts[t];
+            for (int v = vBegin; v < vEnd; ++v)
+                if (root[v] == v) newId[v] = static_cast<int>(id++);
+            sync.arrive_and_wait();
+            size_t kept = 0;
+            for (size_t i = aBegin; i < aEnd; ++i) {
+                arcs[i].u = newId[root[arcs[i].u]];
+                arcs[i].v = newId[root[arcs[i].v]];
+                if (arcs[i].u != arcs[i].v) ++kept;
+            }
+            counts[t] = kept;
+            sync.arrive_and_wait();
+            size_t out = counts[t];
+            for (size_t i = aBegin; i < aEnd; ++i)
+                if (arcs[i].u != arcs[i].v) next[out++] = arcs[i];
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& w : workers) w.join();
+
+    // kolejnosc wyniku jak w Kruskalu (rosnace wagi), niezalezna od liczby watkow
+    std::vector<int> ids;
+    for (const std::vector<int>& part : chosen) ids.insert(ids.end(), part.begin(), part.end());
+    parallelSort(ids.begin(), ids.end(), threads, [&](int a, int b) {
+        return key(edges[a].weight, a) < key(edges[b].weight, b);
+    });
+    std::vector<Edge> mstEdges(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) mstEdges[i] = edges[ids[i]];
     return mstEdges;
 }
 
 // Zwraca wektor odlegoci od startu
-std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstra(const Graph& g, int start) {
+template <typename G>
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstraImpl(const G& g, int start) {
     std::vector<int> dist(g.vertices, std::numeric_limits<int>::max());
     std::vector<int> prev(g.vertices, -1);
     dist[start] = 0;
@@ -138,55 +1066,846 @@ std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstra(const Gr
         int d = top.first;
         int u = top.second;
         if (d > dist[u]) continue;
-        for (const std::pair<int, int>& p : g.adjList[u]) {
-            int v = p.first, w = p.second;
+        forEachNeighbor(g, u, [&](int v, int w) {
             if (dist[u] + w < dist[v]) {
                 dist[v] = dist[u] + w;
                 prev[v] = u;
                 pq.emplace(dist[v], v);
             }
-        }
+        });
     }
     return { dist, prev };
 }
 
+template <typename G>
+void GraphAlgorithms::dijkstraInto(const G& g, int start, const std::vector<int>& targets, ShortestPathWorkspace& ws) {
+    ws.reset(g.vertices);
+    int remaining = 0;
+    for (int t : targets)
+        if (!ws.pending[t]) {
+            ws.pending[t] = 1;
+            ++remaining;
+        }
+
+    std::greater<std::pair<int, int>> later;
+    ws.dist[start] = 0;
+    ws.touched.push_back(start);
+    ws.heap.emplace_back(0, start);
+    while (!ws.heap.empty()) {
+        std::pop_heap(ws.heap.begin(), ws.heap.end(), later);
+        auto [d, u] = ws.heap.back();
+        ws.heap.pop_back();
+        if (d > ws.dist[u]) continue;
+        if (ws.pending[u]) {
+            ws.pending[u] = 0;
+            if (--remaining == 0) break;
+        }
+        forEachNeighbor(g, u, [&](int v, int w) {
+            if (d + w < ws.dist[v]) {
+                if (ws.dist[v] == std::numeric_limits<int>::max()) ws.touched.push_back(v);
+                ws.dist[v] = d + w;
+                ws.prev[v] = u;
+                ws.heap.emplace_back(d + w, v);
+                std::push_heap(ws.heap.begin(), ws.heap.end(), later);
+            }
+        });
+    }
+    // cele nieosiagalne zostaja oznaczone - czyszczone tu, bo nie ma ich w touched
+    for (int t : targets) ws.pending[t] = 0;
+}
+
+// Heurystyka tylko dopuszczalna (nie musi byc spojna), wiec wierzcholek moze zostac rozwiniety ponownie;
+// cel zdjety z kolejki ma juz odleglosc optymalna.
+template <typename G, typename H>
+PathResult GraphAlgorithms::aStar(const G& g, int source, int target, H&& heuristic) {
+    const int INF = std::numeric_limits<int>::max();
+    PathResult result;
+    std::vector<int> dist(g.vertices, INF);
+    std::vector<int> prev(g.vertices, -1);
+    // (odleglosc + heurystyka, odleglosc, wierzcholek), wpisy nieaktualne pomijane leniwie
+    using Entry = std::tuple<int, int, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+    dist[source] = 0;
+    open.emplace(heuristic(source), 0, source);
+    while (!open.empty()) {
+        int d = std::get<1>(open.top());
+        int u = std::get<2>(open.top());
+        open.pop();
+        if (d > dist[u]) continue;
+        ++result.settled;
+        if (u == target) break;
+        forEachNeighbor(g, u, [&](int v, int w) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
+                prev[v] = u;
+                open.emplace(d + w + heuristic(v), d + w, v);
+            }
+        });
+    }
+    if (dist[target] == INF) return result;
+    result.cost = dist[target];
+    for (int v = target; v != -1; v = prev[v]) result.path.push_back(v);
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
+
+// Rozwijana jest strona o mniejszym minimum kolejki; kazda relaksacja wierzcholka znanego drugiej stronie
+// to kandydat na sciezke. Koniec, gdy suma minimow obu kolejek nie moze juz poprawic najlepszego kandydata.
+template <typename G, typename R>
+PathResult GraphAlgorithms::bidirectionalDijkstra(const G& g, const R& reverse, int source, int target) {
+    const int INF = std::numeric_limits<int>::max();
+    PathResult result;
+    std::vector<int> dist[2] = { std::vector<int>(g.vertices, INF), std::vector<int>(g.vertices, INF) };
+    std::vector<int> prev[2] = { std::vector<int>(g.vertices, -1), std::vector<int>(g.vertices, -1) };
+    using P = std::pair<int, int>;
+    std::priority_queue<P, std::vector<P>, std::greater<>> open[2];
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    open[0].emplace(0, source);
+    open[1].emplace(0, target);
+    long long best = source == target ? 0 : INF;
+    int meet = source == target ? source : -1;
+
+    while (!open[0].empty() && !open[1].empty()
+        && static_cast<long long>(open[0].top().first) + open[1].top().first < best) {
+        int side = open[0].top().first <= open[1].top().first ? 0 : 1;
+        int d = open[side].top().first;
+        int u = open[side].top().second;
+        open[side].pop();
+        if (d > dist[side][u]) continue;
+        ++result.settled;
+        auto relax = [&](int v, int w) {
+            if (d + w >= dist[side][v]) return;
+            dist[side][v] = d + w;
+            prev[side][v] = u;
+            open[side].emplace(d + w, v);
+            if (dist[1 - side][v] != INF && static_cast<long long>(d + w) + dist[1 - side][v] < best) {
+                best = static_cast<long long>(d + w) + dist[1 - side][v];
+                meet = v;
+            }
+        };
+        if (side == 0) forEachNeighbor(g, u, relax);
+        else forEachNeighbor(reverse, u, relax);
+    }
+    if (meet == -1) return result;
+    result.cost = static_cast<int>(best);
+    for (int v = meet; v != -1; v = prev[0][v]) result.path.push_back(v);
+    std::reverse(result.path.begin(), result.path.end());
+    // w drzewie wstecznym prev wskazuje nastepny wierzcholek w strone celu
+    for (int v = prev[1][meet]; v != -1; v = prev[1][v]) result.path.push_back(v);
+    return result;
+}
+
+template <typename G, typename R>
+Landmarks GraphAlgorithms::selectLandmarks(const G& g, const R& reverse, int count) {
+    const int INF = std::numeric_limits<int>::max();
+    const int n = g.vertices;
+    Landmarks landmarks;
+    if (n == 0 || count <= 0) return landmarks;
+    ShortestPathWorkspace ws;
+    const std::vector<int> wholeTree;
+
+    // pierwszy punkt: najdalszy osiagalny z wierzcholka 0
+    dijkstraInto(g, 0, wholeTree, ws);
+    int next = 0;
+    for (int v = 0; v < n; ++v)
+        if (ws.dist[v] != INF && ws.dist[v] > ws.dist[next]) next = v;
+
+    std::vector<std::vector<int>> from, to;
+    std::vector<int> nearest(n, INF);  // odleglosc od najblizszego wybranego punktu
+    while (next != -1 && static_cast<int>(landmarks.vertices.size()) < std::min(count, n)) {
+        landmarks.vertices.push_back(next);
+        dijkstraInto(g, next, wholeTree, ws);
+        from.push_back(ws.dist);
+        dijkstraInto(reverse, next, wholeTree, ws);
+        to.push_back(ws.dist);
+        // kolejny punkt: najdalej od wybranych, ale osiagalny z ktoregos z nich
+        next = -1;
+        int farthest = 0;
+        for (int v = 0; v < n; ++v) {
+            nearest[v] = std::min(nearest[v], from.back()[v]);
+            if (nearest[v] != INF && nearest[v] > farthest) {
+                farthest = nearest[v];
+                next = v;
+            }
+        }
+    }
+
+    const int k = static_cast<int>(landmarks.vertices.size());
+    landmarks.count = k;
+    landmarks.from.resize(static_cast<size_t>(n) * k);
+    landmarks.to.resize(static_cast<size_t>(n) * k);
+    for (int i = 0; i < k; ++i) {
+        for (int v = 0; v < n; ++v) {
+            landmarks.from[static_cast<size_t>(v) * k + i] = from[i][v];
+            landmarks.to[static_cast<size_t>(v) * k + i] = to[i][v];
+        }
+    }
+    return landmarks;
+}
+
 // Zwraca wektor odlegoci od startu
 std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::fordBellman(const Graph& g, int start) {
+    BellmanFordResult r = bellmanFord(g, start);
+    return { std::move(r.dist), std::move(r.prev) };
+}
+
+// Przebiegi relaksacji wszystkich lukow; scanArcs(dist, relax) wywoluje relax(u, v, w) dla kazdego luku.
+// Konczy sie po przebiegu bez zmian; zmiana w przebiegu n-tym oznacza ujemny cykl.
+template <typename Scan>
+BellmanFordResult GraphAlgorithms::bellmanFordPasses(int n, int start, Scan scanArcs) {
+    BellmanFordResult r;
+    bellmanFordPasses(n, start, scanArcs, r);
+    return r;
+}
+
+// Wersja do istniejacego wyniku - assign nie alokuje, gdy r ma juz pojemnosc n
+template <typename Scan>
+void GraphAlgorithms::bellmanFordPasses(int n, int start, Scan scanArcs, BellmanFordResult& r) {
+    const int INF = std::numeric_limits<int>::max();
+    r.dist.assign(n, INF);
+    r.prev.assign(n, -1);
+    r.negativeCycle = false;
+    r.cycle.clear();
+    r.dist[start] = 0;
+
+    bool changed = true;
+    for (int pass = 1; pass <= n && changed; ++pass) {
+        changed = false;
+        scanArcs(r.dist, [&](int u, int v, int w) {
+            if (r.dist[u] != INF && r.dist[u] + w < r.dist[v]) {
+                r.dist[v] = r.dist[u] + w;
+                r.prev[v] = u;
+                changed = true;
+            }
+        });
+    }
+    if (changed) {
+        r.negativeCycle = true;
+        r.cycle = predecessorCycle(r.prev);
+    }
+}
+
+// Wersja dla CSR - pomija wierzcholki jeszcze nieosiagniete
+template <typename G>
+BellmanFordResult GraphAlgorithms::bellmanFordAdjacency(const G& g, int start) {
+    return bellmanFordPasses(g.vertices, start, [&g](const std::vector<int>& dist, auto&& relax) {
+        for (int u = 0; u < g.vertices; ++u) {
+            if (dist[u] == std::numeric_limits<int>::max()) continue;
+            forEachNeighbor(g, u, [&](int v, int w) { relax(u, v, w); });
+        }
+    });
+}
+
+// Przebiegi jak w bellmanFordPasses, wiersz macierzy relaksowany w calosci jadrem SIMD (du stale w wierszu).
+// Ujemna petla w u zmienia dist[u] w trakcie wiersza - taki wiersz przechodzony jest skalarnie.
+void GraphAlgorithms::bellmanFordMatrix(const AdjacencyMatrix& m, int start, BellmanFordResult& r) {
+    const int n = m.vertices;
+    const int INF = std::numeric_limits<int>::max();
+    r.dist.assign(n, INF);
+    r.prev.assign(n, -1);
+    r.negativeCycle = false;
+    r.cycle.clear();
+    r.dist[start] = 0;
+    const SimdKernels& kernels = simd();
+
+    bool changed = true;
+    for (int pass = 1; pass <= n && changed; ++pass) {
+        changed = false;
+        for (int u = 0; u < n; ++u) {
+            if (r.dist[u] == INF) continue;
+            if (m.has(u, u) && m.weight(u, u) < 0) {
+                m.forEachInRow(u, [&](int v, int w) {
+                    if (r.dist[u] + w < r.dist[v]) {
+                        r.dist[v] = r.dist[u] + w;
+                        r.prev[v] = u;
+                        changed = true;
+                    }
+                });
+                continue;
+            }
+            const size_t row = static_cast<size_t>(u);
+            if (kernels.relaxMatrixRow(u, r.dist[u], &m.bits[row * m.wordsPerRow], &m.weights[row * n], n, r.dist.data(), r.prev.data()))
+                changed = true;
+        }
+    }
+    if (changed) {
+        r.negativeCycle = true;
+        r.cycle = predecessorCycle(r.prev);
+    }
+}
+
+// SPFA: kolejka wierzcholkow, ktorych odleglosc zmalala. SLF - wierzcholek tanszy od czola kolejki
+// trafia na jej poczatek; LLL - czolo drozsze od sredniej w kolejce przesuwane jest na koniec.
+// Dlugosc sciezki poprzednikow >= n sygnalizuje mozliwy ujemny cykl, potwierdzany w grafie poprzednikow.
+template <typename G>
+BellmanFordResult GraphAlgorithms::spfa(const G& g, int start) {
+    const int INF = std::numeric_limits<int>::max();
+    int n = g.vertices;
+    BellmanFordResult r;
+    r.dist.assign(n, INF);
+    r.prev.assign(n, -1);
+    r.dist[start] = 0;
+
+    std::deque<int> queue{ start };
+    std::vector<char> inQueue(n, 0);
+    std::vector<int> length(n, 0);
+    inQueue[start] = 1;
+    long long queuedSum = 0;
+
+    while (!queue.empty()) {
+        while (static_cast<long long>(r.dist[queue.front()]) * static_cast<long long>(queue.size()) > queuedSum) {
+            queue.push_back(queue.front());
+            queue.pop_front();
+        }
+        int u = queue.front();
+        queue.pop_front();
+        inQueue[u] = 0;
+        queuedSum -= r.dist[u];
+
+        int du = r.dist[u];
+        int suspect = -1;
+        forEachNeighbor(g, u, [&](int v, int w) {
+            if (du + w >= r.dist[v]) return;
+            if (inQueue[v]) queuedSum -= r.dist[v] - (du + w);
+            r.dist[v] = du + w;
+            r.prev[v] = u;
+            length[v] = length[u] + 1;
+            if (length[v] >= n) suspect = v;
+            if (!inQueue[v]) {
+                inQueue[v] = 1;
+                queuedSum += r.dist[v];
+                if (!queue.empty() && r.dist[v] < r.dist[queue.front()]) queue.push_front(v);
+                else queue.push_back(v);
+            }
+        });
+
+        if (suspect != -1) {
+            r.cycle = predecessorCycle(r.prev);
+            if (!r.cycle.empty()) {
+                r.negativeCycle = true;
+                return r;
+            }
+            // licznik dlugosci byl nieaktualny - liczymy go od nowa wzdluz poprzednikow
+            int len = 0;
+            for (int v = suspect; r.prev[v] != -1 && len < n; v = r.prev[v]) ++len;
+            length[suspect] = len;
+        }
+    }
+    return r;
+}
+
+// Rownolegly Bellman-Ford na grafie lukow wchodzacych: wierzcholki docelowe podzielone na bloki
+// o zblizonej liczbie lukow, kazdy watek liczy nowe odleglosci swojego bloku z tablicy poprzedniego przebiegu
+BellmanFordResult GraphAlgorithms::bellmanFordParallel(const CSRGraph& incoming, int start, unsigned threads) {
+    const int INF = std::numeric_limits<int>::max();
+    int n = incoming.vertices;
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max(n, 1))));
+    BellmanFordResult r;
+    r.dist.assign(n, INF);
+    r.prev.assign(n, -1);
+    r.dist[start] = 0;
+    std::vector<int> next(r.dist);
+
+    std::vector<int> bounds(threads + 1, n);
+    bounds[0] = 0;
+    for (unsigned t = 1; t < threads; ++t) {
+        long long share = static_cast<long long>(incoming.arcCount()) * t / threads;
+        bounds[t] = static_cast<int>(std::lower_bound(incoming.offsets.begin(), incoming.offsets.end() - 1, share) - incoming.offsets.begin());
+    }
+
+    std::vector<char> changed(threads, 0);
+    int pass = 0;
+    bool done = false, anyChanged = false;
+    auto endPass = [&]() noexcept {
+        r.dist.swap(next);
+        anyChanged = std::find(changed.begin(), changed.end(), 1) != changed.end();
+        std::fill(changed.begin(), changed.end(), 0);
+        done = !anyChanged || ++pass >= n;
+    };
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), endPass);
+
+    auto worker = [&](unsigned t) {
+        while (!done) {
+            for (int v = bounds[t]; v < bounds[t + 1]; ++v) {
+                int best = r.dist[v], from = r.prev[v];
+                for (int a = incoming.offsets[v]; a < incoming.offsets[v + 1]; ++a) {
+                    int u = incoming.targets[a];
+                    if (r.dist[u] != INF && r.dist[u] + incoming.weights[a] < best) {
+                        best = r.dist[u] + incoming.weights[a];
+                        from = u;
+                    }
+                }
+                if (best < r.dist[v]) changed[t] = 1;
+                next[v] = best;
+                r.prev[v] = from;
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& w : workers) w.join();
+
+    if (anyChanged) {
+        r.negativeCycle = true;
+        r.cycle = predecessorCycle(r.prev);
+        // przy aktualizacji Jacobiego cykl moze nie byc jeszcze widoczny w poprzednikach
+        if (r.cycle.empty()) r.cycle = spfa(incoming.reversed(), start).cycle;
+    }
+    return r;
+}
+
+std::vector<int> GraphAlgorithms::predecessorCycle(const std::vector<int>& prev) {
+    int n = static_cast<int>(prev.size());
+    std::vector<int> walk(n, -1);  // numer przejscia, w ktorym odwiedzono wierzcholek
+    for (int s = 0; s < n; ++s) {
+        if (walk[s] != -1) continue;
+        int v = s;
+        while (v != -1 && walk[v] == -1) {
+            walk[v] = s;
+            v = prev[v];
+        }
+        if (v == -1 || walk[v] != s) continue;
+        // v lezy na cyklu odkrytym w tym przejsciu; idac po prev otrzymujemy luki w odwrotnej kolejnosci
+        std::vector<int> cycle{ v };
+        for (int u = prev[v]; u != v; u = prev[u]) cycle.push_back(u);
+        cycle.push_back(v);
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+    return {};
+}
+
+template <typename G>
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstraBucketed(const G& g, int start, DijkstraEngine engine, std::pair<int, int> weights) {
+    if (weights.first < 0) throw std::invalid_argument("Dial and radix heap Dijkstra require non-negative weights");
+    if (engine == DijkstraEngine::DIAL && weights.second <= DIAL_MAX_WEIGHT) {
+        DialQueue queue(weights.second);
+        return dijkstraMonotoneImpl(g, start, queue);
+    }
+    RadixHeap queue;
+    return dijkstraMonotoneImpl(g, start, queue);
+}
+
+// Dijkstra na kolejce monotonicznej (Dial, radix) - przestarzale wpisy pomijane przy zdejmowaniu
+template <typename Queue, typename G>
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstraMonotoneImpl(const G& g, int start, Queue& queue) {
     std::vector<int> dist(g.vertices, std::numeric_limits<int>::max());
     std::vector<int> prev(g.vertices, -1);
     dist[start] = 0;
+    queue.push(0, start);
 
-    for (int i = 1; i < g.vertices; ++i) {
-        for (const Edge& e : g.edges) {
-            int u = e.from, v = e.to, w = e.weight;
-            if (dist[u] != std::numeric_limits<int>::max() && dist[u] + w < dist[v]) {
-                dist[v] = dist[u] + w;
+    while (!queue.empty()) {
+        std::pair<int, int> top = queue.pop();
+        int d = top.first;
+        int u = top.second;
+        if (d > dist[u]) continue;
+        forEachNeighbor(g, u, [&](int v, int w) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
                 prev[v] = u;
+                queue.push(dist[v], v);
+            }
+        });
+    }
+    return { dist, prev };
+}
+
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::deltaStepping(const Graph& g, int start, int delta, unsigned threads) {
+    return deltaStepping(CSRGraph(g), start, delta, threads);
+}
+
+// Delta-stepping: kubelek i zawiera wierzcholki o odleglosci z [i * delta, (i + 1) * delta).
+// Luki lekkie (w <= delta) relaksowane sa powtarzalnie az kubelek sie oprozni, ciezkie raz po jego zamknieciu.
+// Odleglosc i poprzednik trzymane w jednym 64-bitowym slowie atomowym, aktualizowanym przez CAS.
+// Watki pracuja na stalym zestawie; scalanie wynikow i wybor kolejnej fazy wykonuje funkcja zakonczenia bariery.
+// Oczekujace odleglosci mieszcza sie w oknie maxWaga / delta + 2 kubelkow od biezacego, wiec tablica kubelkow
+// jest cykliczna; delta zwiekszana jest tak, zeby okno nie przekroczylo DELTA_MAX_BUCKETS.
+constexpr int DELTA_MAX_BUCKETS = 1 << 20;
+
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::deltaStepping(const CSRGraph& g, int start, int delta, unsigned threads) {
+    int n = g.vertices;
+    std::pair<int, int> weights = weightRange(g);
+    if (weights.first < 0) throw std::invalid_argument("Delta-stepping requires non-negative weights");
+    if (delta <= 0) {
+        long long avgDegree = std::max<long long>(1, g.arcCount() / std::max(n, 1));
+        delta = static_cast<int>(std::max<long long>(1, weights.second / avgDegree));
+    }
+    delta = std::max(delta, weights.second / (DELTA_MAX_BUCKETS - 2) + 1);
+    const int slots = weights.second / delta + 2;
+    threads = std::max(1u, threads);
+
+    // luki kazdego wierzcholka uporzadkowane: najpierw lekkie [offsets[u], lightEnd[u]), potem ciezkie
+    std::vector<int> targets(g.targets.size()), arcWeights(g.weights.size()), lightEnd(n);
+    for (int u = 0; u < n; ++u) {
+        int lo = g.offsets[u], hi = g.offsets[u + 1];
+        for (int a = g.offsets[u]; a < g.offsets[u + 1]; ++a) {
+            int slot = g.weights[a] <= delta ? lo++ : --hi;
+            targets[slot] = g.targets[a];
+            arcWeights[slot] = g.weights[a];
+        }
+        lightEnd[u] = lo;
+    }
+
+    const uint64_t INF = static_cast<uint64_t>(std::numeric_limits<int>::max()) << 32 | 0xFFFFFFFFu;
+    auto pack = [](int d, int p) { return static_cast<uint64_t>(d) << 32 | static_cast<uint32_t>(p); };
+    auto distOf = [](uint64_t s) { return static_cast<int>(s >> 32); };
+    std::vector<std::atomic<uint64_t>> state(n);
+    for (std::atomic<uint64_t>& s : state) s.store(INF, std::memory_order_relaxed);
+    state[start].store(pack(0, -1), std::memory_order_relaxed);
+
+    // kubelek numer b w buckets[b % slots]; pending - wpisy we wszystkich kubelkach (rowniez nieaktualne)
+    std::vector<std::vector<int>> buckets(slots);
+    buckets[0].push_back(start);
+    size_t pending = 1;
+    std::vector<std::vector<std::pair<int, int>>> requests(threads);  // (wierzcholek, nowa odleglosc)
+    std::vector<int> frontier, settled;
+    std::vector<int> mark(n, -1);
+    int current = 0, phase = 0;
+    bool heavyStage = false, done = false;
+    std::exception_ptr error;
+
+    // wierzcholki z kubelka 'current' o aktualnej odleglosci, bez powtorzen w obrebie fazy
+    auto takeBucket = [&]() {
+        frontier.clear();
+        ++phase;
+        std::vector<int>& bucket = buckets[current % slots];
+        for (int v : bucket) {
+            if (distOf(state[v].load(std::memory_order_relaxed)) / delta != current || mark[v] == phase) continue;
+            mark[v] = phase;
+            frontier.push_back(v);
+        }
+        pending -= bucket.size();
+        bucket.clear();
+    };
+
+    auto advance = [&]() {
+        for (std::vector<std::pair<int, int>>& local : requests) {
+            for (const std::pair<int, int>& r : local) buckets[r.second / delta % slots].push_back(r.first);
+            pending += local.size();
+            local.clear();
+        }
+        if (!heavyStage) settled.insert(settled.end(), frontier.begin(), frontier.end());
+
+        while (true) {
+            if (!heavyStage) {
+                takeBucket();
+                if (!frontier.empty()) return;
+                // kubelek pusty - relaksacja ciezkich lukow wszystkich wierzcholkow z kubelka
+                heavyStage = true;
+                frontier.clear();
+                ++phase;
+                for (int v : settled) {
+                    if (mark[v] == phase) continue;
+                    mark[v] = phase;
+                    frontier.push_back(v);
+                }
+                settled.clear();
+                if (!frontier.empty()) return;
+            }
+            heavyStage = false;
+            if (pending == 0) {
+                done = true;
+                return;
+            }
+            do { ++current; } while (buckets[current % slots].empty());
+        }
+    };
+
+    // funkcja zakonczenia bariery musi byc noexcept - blad (np. brak pamieci) konczy petle i wraca po join
+    auto nextPhase = [&]() noexcept {
+        try {
+            advance();
+        }
+        catch (...) {
+            error = std::current_exception();
+            done = true;
+        }
+    };
+
+    auto relax = [&](int v, int nd, int u, std::vector<std::pair<int, int>>& out) {
+        uint64_t cur = state[v].load(std::memory_order_relaxed);
+        while (distOf(cur) > nd) {
+            if (state[v].compare_exchange_weak(cur, pack(nd, u), std::memory_order_relaxed)) {
+                out.emplace_back(v, nd);
+                return;
+            }
+        }
+    };
+
+    takeBucket();
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), nextPhase);
+    auto worker = [&](unsigned t) {
+        while (!done) {
+            size_t begin = frontier.size() * t / threads, end = frontier.size() * (t + 1) / threads;
+            for (size_t i = begin; i < end; ++i) {
+                int u = frontier[i];
+                int du = distOf(state[u].load(std::memory_order_relaxed));
+                int lo = heavyStage ? lightEnd[u] : g.offsets[u];
+                int hi = heavyStage ? g.offsets[u + 1] : lightEnd[u];
+                for (int a = lo; a < hi; ++a) relax(targets[a], du + arcWeights[a], u, requests[t]);
             }
+            sync.arrive_and_wait();
         }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& w : workers) w.join();
+    if (error) std::rethrow_exception(error);
+
+    std::vector<int> dist(n), prev(n);
+    for (int v = 0; v < n; ++v) {
+        uint64_t s = state[v].load(std::memory_order_relaxed);
+        dist[v] = distOf(s);
+        prev[v] = static_cast<int>(static_cast<uint32_t>(s));
     }
     return { dist, prev };
 }
 
+// Dijkstra O(V^2) bez kopca - wybor minimum skanem tablicy, sasiedzi z bitmapy wiersza
+std::pair<std::vector<int>, std::vector<int>> GraphAlgorithms::dijkstraDense(const AdjacencyMatrix& m, int start) {
+    int n = m.vertices;
+    std::vector<int> dist(n, std::numeric_limits<int>::max());
+    std::vector<int> prev(n, -1);
+    std::vector<bool> done(n, false);
+    dist[start] = 0;
+
+    for (int count = 0; count < n; ++count) {
+        int u = -1;
+        for (int v = 0; v < n; ++v)
+            if (!done[v] && dist[v] != std::numeric_limits<int>::max() && (u == -1 || dist[v] < dist[u]))
+                u = v;
+        if (u == -1) break;
+
+        done[u] = true;
+        m.forEachInRow(u, [&](int v, int w) {
+            if (!done[v] && dist[u] + w < dist[v]) {
+                dist[v] = dist[u] + w;
+                prev[v] = u;
+            }
+        });
+    }
+    return { dist, prev };
+}
+
+// Dinic: BFS wyznacza graf warstwowy, sciezki powiekszajace szukane iteracyjnym DFS
+// z wskaznikami biezacego luku; po powiekszeniu DFS wraca do poczatku pierwszego nasyconego luku
+long long GraphAlgorithms::dinicFlow(FlowNetwork& net, int source, int sink) {
+    int n = net.vertices;
+    std::vector<int> level(n), current(n), queue(n), path;
+    long long flow = 0;
+    if (source == sink) return 0;
+
+    while (true) {
+        std::fill(level.begin(), level.end(), -1);
+        level[source] = 0;
+        int qHead = 0, qTail = 0;
+        queue[qTail++] = source;
+        while (qHead < qTail && level[sink] == -1) {
+            int u = queue[qHead++];
+            for (int a = net.offsets[u]; a < net.offsets[u + 1]; ++a) {
+                if (net.cap[a] > 0 && level[net.head[a]] == -1) {
+                    level[net.head[a]] = level[u] + 1;
+                    queue[qTail++] = net.head[a];
+                }
+            }
+        }
+        if (level[sink] == -1) return flow;
+
+        std::copy(net.offsets.begin(), net.offsets.end() - 1, current.begin());
+        path.clear();
+        int u = source;
+        while (true) {
+            if (u == sink) {
+                long long pushed = std::numeric_limits<long long>::max();
+                size_t firstSaturated = 0;
+                for (size_t i = 0; i < path.size(); ++i) {
+                    if (net.cap[path[i]] < pushed) {
+                        pushed = net.cap[path[i]];
+                        firstSaturated = i;
+                    }
+                }
+                for (int a : path) {
+                    net.cap[a] -= pushed;
+                    net.cap[net.rev[a]] += pushed;
+                }
+                flow += pushed;
+                path.resize(firstSaturated);
+                u = path.empty() ? source : net.head[path.back()];
+                continue;
+            }
+
+            int& a = current[u];
+            while (a < net.offsets[u + 1] && (net.cap[a] == 0 || level[net.head[a]] != level[u] + 1)) ++a;
+            if (a < net.offsets[u + 1]) {
+                path.push_back(a);
+                u = net.head[a];
+                continue;
+            }
+            // slepy zaulek - wierzcholek usuwany z grafu warstwowego, cofamy sie o jeden luk
+            level[u] = -1;
+            if (path.empty()) break;
+            u = net.tail(path.back());
+            path.pop_back();
+            ++current[u];
+        }
+    }
+}
+
+// Dokladne wysokosci: odleglosc do ujscia w sieci residualnej (BFS wstecz), n dla nieosiagalnych
+void GraphAlgorithms::globalRelabel(const FlowNetwork& net, int sink, std::vector<int>& height) {
+    int n = net.vertices;
+    height.assign(n, n);
+    std::vector<int> queue{ sink };
+    height[sink] = 0;
+    for (size_t i = 0; i < queue.size(); ++i) {
+        int v = queue[i];
+        for (int a = net.offsets[v]; a < net.offsets[v + 1]; ++a) {
+            int u = net.head[a];
+            // luk u -> v jest para luku a
+            if (height[u] == n && net.cap[net.rev[a]] > 0) {
+                height[u] = height[v] + 1;
+                queue.push_back(u);
+            }
+        }
+    }
+}
+
+// Push-relabel z wyborem aktywnego wierzcholka o najwyzszej etykiecie, heurystyka przerwy (gap)
+// i okresowym globalnym przeetykietowaniem. Liczona jest tylko faza pierwsza (maksymalny przeplyw wstepny),
+// ktora wystarcza do wartosci przeplywu i przekroju minimalnego.
+long long GraphAlgorithms::pushRelabelFlow(FlowNetwork& net, int source, int sink) {
+    int n = net.vertices;
+    if (source == sink) return 0;
+    std::vector<long long> excess(n, 0);
+    std::vector<int> height, current(net.offsets.begin(), net.offsets.end() - 1), count(2 * n + 1, 0);
+    std::vector<std::vector<int>> active(n);
+    int highest = -1;
+
+    auto activate = [&](int v) {
+        if (v == source || v == sink || height[v] >= n) return;
+        active[height[v]].push_back(v);
+        highest = std::max(highest, height[v]);
+    };
+    auto relabelAll = [&]() {
+        globalRelabel(net, sink, height);
+        height[source] = n;
+        std::fill(count.begin(), count.end(), 0);
+        for (int v = 0; v < n; ++v) ++count[height[v]];
+        for (std::vector<int>& bucket : active) bucket.clear();
+        highest = -1;
+        for (int v = 0; v < n; ++v)
+            if (excess[v] > 0) activate(v);
+    };
+
+    for (int a = net.offsets[source]; a < net.offsets[source + 1]; ++a) {
+        long long c = net.cap[a];
+        if (c == 0) continue;
+        net.cap[a] = 0;
+        net.cap[net.rev[a]] += c;
+        excess[net.head[a]] += c;
+        excess[source] -= c;
+    }
+    relabelAll();
+
+    long long relabelWork = 0;
+    const long long globalRelabelPeriod = 6LL * n + net.offsets[n];
+
+    while (highest >= 0) {
+        if (active[highest].empty()) {
+            --highest;
+            continue;
+        }
+        int u = active[highest].back();
+        active[highest].pop_back();
+        if (height[u] != highest || excess[u] == 0) continue;
+
+        // rozladowanie u
+        while (excess[u] > 0) {
+            int& a = current[u];
+            if (a == net.offsets[u + 1]) {
+                int oldHeight = height[u];
+                int newHeight = 2 * n;
+                for (int b = net.offsets[u]; b < net.offsets[u + 1]; ++b)
+                    if (net.cap[b] > 0) newHeight = std::min(newHeight, height[net.head[b]] + 1);
+                relabelWork += net.offsets[u + 1] - net.offsets[u] + 12;
+                --count[oldHeight];
+                height[u] = std::min(newHeight, n);
+                ++count[height[u]];
+                current[u] = net.offsets[u];
+                // przerwa: nikt nie ma wysokosci oldHeight, wiec wyzsze wierzcholki nie dojda do ujscia
+                if (count[oldHeight] == 0 && oldHeight < n) {
+                    for (int v = 0; v < n; ++v) {
+                        if (height[v] > oldHeight && height[v] < n) {
+                            --count[height[v]];
+                            height[v] = n;
+                            ++count[n];
+                        }
+                    }
+                }
+                if (height[u] >= n) break;
+                continue;
+            }
+            int v = net.head[a];
+            if (net.cap[a] > 0 && height[u] == height[v] + 1) {
+                long long delta = std::min(excess[u], net.cap[a]);
+                bool wasIdle = excess[v] == 0;
+                net.cap[a] -= delta;
+                net.cap[net.rev[a]] += delta;
+                excess[u] -= delta;
+                excess[v] += delta;
+                if (wasIdle) activate(v);
+            }
+            else {
+                ++a;
+            }
+        }
+        if (excess[u] > 0) activate(u);
+
+        if (relabelWork > globalRelabelPeriod) {
+            relabelWork = 0;
+            relabelAll();
+        }
+    }
+    return excess[sink];
+}
+
+MaxFlowResult GraphAlgorithms::minCut(const Graph& g, long long flow, std::vector<char> sourceSide) {
+    MaxFlowResult result;
+    result.flow = flow;
+    for (const Edge& e : g.edges) {
+        bool crosses = sourceSide[e.from] && !sourceSide[e.to];
+        if (!g.directed) crosses = crosses || (sourceSide[e.to] && !sourceSide[e.from]);
+        if (crosses) result.cutEdges.push_back(e);
+    }
+    result.sourceSide = std::move(sourceSide);
+    return result;
+}
+
 // Funkcja pomocnicza BFS do algorytmu Forda-Fulkersona
-bool bfs_ff(int s, int t, std::vector<int>& parent, const std::vector<std::vector<int>>& residual, int V) {
-    std::fill(parent.begin(), parent.end(), -1);
-    parent[s] = -2;
-    std::queue<std::pair<int, int>> q;
-    q.push({ s, INT_MAX });
-
-    while (!q.empty()) {
-        int cur = q.front().first;
-        int flow = q.front().second;
-        q.pop();
-
-        for (int next = 0; next < V; ++next) {
-            if (parent[next] == -1 && residual[cur][next] > 0) {
-                parent[next] = cur;
-                int new_flow = std::min(flow, residual[cur][next]);
+// na macierzy residualnej (wiersze po V); parent z resetem przez epoke, kolejka z bufora wielokrotnego uzytku
+bool bfs_ff(int s, int t, StampedArray<int>& parent, const std::vector<int>& residual, int V, std::vector<int>& queue) {
+    parent.reset(V, -1);
+    parent.set(s, -2);
+    queue.clear();
+    queue.push_back(s);
+    const SimdKernels& kernels = simd();
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cur = queue[head];
+        const int* row = residual.data() + static_cast<size_t>(cur) * V;
+        // kolejne kolumny z dodatnia przepustowoscia wyszukiwane wektorowo
+        for (int next = kernels.nextPositive(row, 0, V); next < V; next = kernels.nextPositive(row, next + 1, V)) {
+            if (parent.get(next) == -1) {
+                parent.set(next, cur);
                 if (next == t)
                     return true;
-                q.push({ next, new_flow });
+                queue.push_back(next);
             }
         }
     }
@@ -194,31 +1913,43 @@ bool bfs_ff(int s, int t, std::vector<int>& parent, const std::vector<std::vecto
 }
 
 // Zwraca maksymalny przepyw
-int GraphAlgorithms::fordFulkerson(Graph& g, int source, int sink) {
+template <typename G>
+int GraphAlgorithms::fordFulkersonImpl(const G& g, int source, int sink, AlgorithmWorkspace& ws) {
     int V = g.vertices;
-    std::vector<std::vector<int>> capacity(V, std::vector<int>(V, 0));
-    for (const Edge& edge : g.edges) {
-        capacity[edge.from][edge.to] += edge.weight;
+    std::vector<int>& residual = ws.residual;
+    {
+        PhaseScope phase("build");
+        residual.assign(static_cast<size_t>(V) * V, 0);
+        edgeListInto(g, ws.edges);
+        for (const Edge& edge : ws.edges) {
+            residual[static_cast<size_t>(edge.from) * V + edge.to] += edge.weight;
+        }
     }
-
-    std::vector<std::vector<int>> residual = capacity;
-    std::vector<int> parent(V);
+    auto at = [&](int u, int v) -> int& { return residual[static_cast<size_t>(u) * V + v]; };
     int maxFlow = 0;
 
-    while (bfs_ff(source, sink, parent, residual, V)) {
+    while (true) {
+        bool found;
+        {
+            PhaseScope phase("bfs");
+            found = bfs_ff(source, sink, ws.bfsParent, residual, V, ws.queue);
+        }
+        if (!found) break;
+
+        PhaseScope phase("augment");
         int flow = INT_MAX;
         int cur = sink;
         while (cur != source) {
-            int prev = parent[cur];
-            flow = std::min(flow, residual[prev][cur]);
+            int prev = ws.bfsParent.get(cur);
+            flow = std::min(flow, at(prev, cur));
             cur = prev;
         }
 
         cur = sink;
         while (cur != source) {
-            int prev = parent[cur];
-            residual[prev][cur] -= flow;
-            residual[cur][prev] += flow;
+            int prev = ws.bfsParent.get(cur);
+            at(prev, cur) -= flow;
+            at(cur, prev) += flow;
             cur = prev;
         }
 
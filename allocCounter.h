@@ -0,0 +1,10 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// Licznik alokacji z podmienionego globalnego operator new (allocCounter.cpp) - liczy wszystkie watki
+long long allocationCount();
+long long allocatedBytes();
+// Tylko alokacje biezacego watku (bez watkow, ktore uruchomil) - dla pomiarow wykonywanych rownolegle
+long long threadAllocationCount();
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <mutex>
+#include <unordered_map>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include "algorithms.h"
+#include "parallel.h"
+#include "loader.h"
+
+// Macierz odleglosci ma V^2 pozycji - powyzej tej liczby wierzcholkow --all-pairs jest odrzucane
+constexpr int BATCH_ALL_PAIRS_LIMIT = 10000;
+
+// Zapytanie o najkrotsza sciezke; target == -1 - odleglosci do wszystkich wierzcholkow
+struct PathQuery {
+    int source;
+    int target;
+};
+
+// Zapytania z pliku tekstowego: pary "zrodlo cel" (dowolne biale znaki miedzy liczbami)
+std::vector<PathQuery> loadQueries(const std::string& filename, int vertices) {
+    MappedFile file(filename);
+    const char* p = file.data();
+    const char* end = p + file.size();
+    std::vector<PathQuery> queries;
+    int s, t;
+    while (scanInt(p, end, s, file.data())) {
+        if (!scanInt(p, end, t, file.data())) throw std::runtime_error("Query file: missing target for last query");
+        if (s < 0 || s >= vertices || t < -1 || t >= vertices) throw std::runtime_error("Query file: vertex id out of range");
+        queries.push_back({ s, t });
+    }
+    return queries;
+}
+
+// Zapytania o wspolnym zrodle - jedno przejscie Dijkstry odpowiada na wszystkie
+struct QueryGroup {
+    int source;
+    std::vector<size_t> queries;   // indeksy w kolejnosci z pliku
+    std::vector<int> targets;      // puste, gdy ktores zapytanie dotyczy wszystkich wierzcholkow
+};
+
+// Grupy w kolejnosci pierwszego wystapienia zrodla
+std::vector<QueryGroup> groupBySource(const std::vector<PathQuery>& queries) {
+    std::vector<QueryGroup> groups;
+    std::unordered_map<int, size_t> index;
+    std::vector<char> wholeTree;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto it = index.emplace(queries[i].source, groups.size()).first;
+        if (it->second == groups.size()) {
+            groups.push_back({ queries[i].source, {}, {} });
+            wholeTree.push_back(0);
+        }
+        QueryGroup& group = groups[it->second];
+        group.queries.push_back(i);
+        if (queries[i].target == -1) wholeTree[it->second] = 1;
+        else group.targets.push_back(queries[i].target);
+    }
+    for (size_t g = 0; g < groups.size(); ++g)
+        if (wholeTree[g]) groups[g].targets.clear();
+    return groups;
+}
+
+// Wyniki grup wypisywane w kolejnosci grup, gdy tylko kolejna jest gotowa - pamiec zajmuja
+// jedynie grupy zakonczone przed poprzedzajacymi je w kolejnosci
+class OrderedWriter {
+public:
+    OrderedWriter(std::ostream& out, size_t count) : out(out), slots(count), ready(count, 0) {}
+
+    void submit(size_t index, std::string text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        slots[index] = std::move(text);
+        ready[index] = 1;
+        while (next < slots.size() && ready[next]) {
+            out << slots[next];
+            std::string().swap(slots[next]);
+            ++next;
+        }
+    }
+
+private:
+    std::ostream& out;
+    std::vector<std::string> slots;
+    std::vector<char> ready;
+    size_t next = 0;
+    std::mutex mutex;
+};
+
+void appendPath(std::string& line, const ShortestPathWorkspace& ws, int target) {
+    std::vector<int> path;
+    for (int v = target; v != -1; v = ws.prev[v]) path.push_back(v);
+    line += " |";
+    for (size_t i = path.size(); i-- > 0;) {
+        line += ' ';
+        line += std::to_string(path[i]);
+    }
+}
+
+// Odleglosci do wszystkich wierzcholkow w jednej linii, '-' dla nieosiagalnych
+void appendAllDistances(std::string& line, const ShortestPathWorkspace& ws) {
+    for (size_t v = 0; v < ws.dist.size(); ++v) {
+        line += v ? ' ' : ':';
+        if (v == 0) line += ' ';
+        if (ws.dist[v] == std::numeric_limits<int>::max()) line += '-';
+        else line += std::to_string(ws.dist[v]);
+    }
+}
+
+// Odpowiada na zapytania: grupy rozdzielane dynamicznie miedzy watki, kazdy watek ma wlasny
+// ShortestPathWorkspace. Linia wyniku: "s t koszt" (lub "s t brak"), z --paths dodatkowo "| sciezka";
+// dla t = -1: "s: d0 d1 ...". Zwraca liczbe grup (roznych zrodel).
+template <typename G>
+size_t runBatchQueries(const G& g, const std::vector<PathQuery>& queries, std::ostream& out, unsigned threads, bool paths) {
+    std::vector<QueryGroup> groups = groupBySource(queries);
+    std::vector<ShortestPathWorkspace> workspaces(std::max(1u, threads));
+    OrderedWriter writer(out, groups.size());
+    parallelForDynamic(groups.size(), threads, [&](size_t gi, unsigned tid) {
+        const QueryGroup& group = groups[gi];
+        ShortestPathWorkspace& ws = workspaces[tid];
+        GraphAlgorithms::dijkstraInto(g, group.source, group.targets, ws);
+        std::string text;
+        for (size_t qi : group.queries) {
+            const PathQuery& q = queries[qi];
+            text += std::to_string(q.source);
+            if (q.target == -1) appendAllDistances(text, ws);
+            else {
+                text += ' ';
+                text += std::to_string(q.target);
+                if (ws.dist[q.target] == std::numeric_limits<int>::max()) text += " brak";
+                else {
+                    text += ' ';
+                    text += std::to_string(ws.dist[q.target]);
+                    if (paths) appendPath(text, ws, q.target);
+                }
+            }
+            text += '\n';
+        }
+        writer.submit(gi, std::move(text));
+    });
+    return groups.size();
+}
+
+// Zapytania punkt-punkt (--search): query(s, t) -> PathResult na przygotowaniu wspolnym dla wszystkich watkow,
+// zapytania rozdzielane dynamicznie blokami po BATCH_POINT_BLOCK; zapytania o wszystkie wierzcholki (t = -1)
+// - pelny Dijkstra na buforze watku. Wiersze jak w runBatchQueries, ale w kolejnosci z pliku.
+constexpr size_t BATCH_POINT_BLOCK = 64;
+
+template <typename G, typename Query>
+void runBatchPointToPoint(const G& g, const std::vector<PathQuery>& queries, std::ostream& out, unsigned threads, bool paths,
+    Query&& query) {
+    const size_t blocks = (queries.size() + BATCH_POINT_BLOCK - 1) / BATCH_POINT_BLOCK;
+    std::vector<ShortestPathWorkspace> workspaces(std::max(1u, threads));
+    OrderedWriter writer(out, blocks);
+    const std::vector<int> wholeTree;
+    parallelForDynamic(blocks, threads, [&](size_t b, unsigned tid) {
+        std::string text;
+        for (size_t qi = b * BATCH_POINT_BLOCK; qi < std::min(queries.size(), (b + 1) * BATCH_POINT_BLOCK); ++qi) {
+            const PathQuery& q = queries[qi];
+            text += std::to_string(q.source);
+            if (q.target == -1) {
+                GraphAlgorithms::dijkstraInto(g, q.source, wholeTree, workspaces[tid]);
+                appendAllDistances(text, workspaces[tid]);
+            }
+            else {
+                PathResult r = query(q.source, q.target);
+                text += ' ';
+                text += std::to_string(q.target);
+                if (r.path.empty()) text += " brak";
+                else {
+                    text += ' ';
+                    text += std::to_string(r.cost);
+                    if (paths) {
+                        text += " |";
+                        for (int v : r.path) {
+                            text += ' ';
+                            text += std::to_string(v);
+                        }
+                    }
+                }
+            }
+            text += '\n';
+        }
+        writer.submit(b, std::move(text));
+    });
+}
+
+// Macierz odleglosci wszystkich par (dla malych grafow): wiersz s to "s: d0 d1 ..."
+std::vector<PathQuery> allPairsQueries(int vertices) {
+    std::vector<PathQuery> queries(vertices);
+    for (int s = 0; s < vertices; ++s) queries[s] = { s, -1 };
+    return queries;
+}
+
+#endif // BATCH_H
@@ -0,0 +1,1050 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
+#include <type_traits>
+#include <cerrno>
+#include "algorithms.h"
+#include "modes.h"
+#include "timer.h"
+#include "perfCounters.h"
+#include "reorder.h"
+#include "allocCounter.h"
+#include "dynamicGraph.h"
+#include "parallel.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#define GRAPH_HAS_FORK 1
+#endif
+
+// Parametry pomiaru: kazdy przypadek na kazdym grafie wykonywany jest warmup razy bez pomiaru,
+// a nastepnie repeats razy albo - gdy budgetMs > 0 - az suma zmierzonych czasow przekroczy budzet.
+struct BenchmarkConfig {
+    int graphs = 5;          // liczba roznych grafow losowych (ziarna trialSeed(seed, i))
+    int warmup = 1;
+    int repeats = 10;
+    double budgetMs = 0;
+    int vertices = 0;
+    double density = 0;
+    bool directed = true;
+    bool counters = false;   // liczniki sprzetowe i czasy faz (--counters)
+    VertexOrder reorder = VertexOrder::NONE;  // --reorder: przypadki powtarzane na przenumerowanym grafie
+    bool workspace = false;  // --workspace: bufory algorytmow wspolne dla wszystkich przebiegow przypadku
+    GraphTypes types = GraphTypes::INT;       // --types: przypadki powtarzane na BasicCSRGraph o tych typach
+    unsigned jobs = 1;       // --jobs: pomiary (przypadek x reprezentacja x graf) wykonywane naraz; 1 - kolejno
+    bool isolate = false;    // --isolate: przy jobs > 1 mierzone przebiegi wykonywane pojedynczo
+    bool pin = false;        // --pin: watek roboczy t przypiety do procesora t
+    int pairs = 1;           // --pairs: zapytania punkt-punkt w jednym mierzonym przebiegu (pierwsze 0 -> V-1)
+    GeneratorOptions generator;
+};
+
+struct SampleStats {
+    size_t count = 0;
+    double minNs = 0, medianNs = 0, meanNs = 0, p95Ns = 0, stddevNs = 0;
+};
+
+// Faza algorytmu (PhaseScope) zebrana ze wszystkich mierzonych przebiegow
+struct PhaseResult {
+    std::vector<long long> samplesNs;   // laczny czas fazy w kolejnych przebiegach
+    CounterValues counters{};           // suma po przebiegach
+    SampleStats stats;
+};
+
+// Wynik jednej kolumny (przypadek x reprezentacja) zebrany ze wszystkich grafow
+struct BenchmarkResult {
+    GraphRepresentation representation;
+    std::string name;
+    std::vector<long long> samplesNs;
+    long long digest = 0;    // wartosc kontrolna z ostatniego przebiegu
+    SampleStats stats;
+    CounterValues counters{};           // suma po mierzonych przebiegach
+    std::array<bool, COUNTER_EVENTS> counterAvailable{};
+    std::map<std::string, PhaseResult> phases;
+    double speedup = 0;      // mediana wersji bazowej (graf wejsciowy, CSR z int, pierwsza liczba watkow serii) / mediana tego wiersza; 0 - nie dotyczy
+    double efficiency = 0;   // skalowanie silne: speedup * watki bazowe / watki; 0 - poza seria --threads
+    long long allocations = 0;          // operator new w mierzonych przebiegach (wszystkie watki; przy --jobs watek pomiaru)
+    long long overlaps = 0;             // mierzone przebiegi innych zadan nakladajace sie na przebiegi tego wiersza
+};
+
+// Pomiary wykonywane rownolegle (--jobs > 1). Dla kazdego mierzonego przebiegu liczone sa mierzone przebiegi
+// innych zadan, ktore sie z nim nakladaja (trwajace w chwili startu i rozpoczete przed jego koncem).
+// Z isolate mierzony przebieg czeka, az pozostale zadania wyjda z pracy poza pomiarem (budowa grafow,
+// rozgrzewka), a nowa praca nie zaczyna sie, dopoki on trwa albo na to czeka - przebiegi ida pojedynczo.
+class ConcurrentRuns {
+public:
+    explicit ConcurrentRuns(bool isolate) : isolate(isolate) {}
+
+    // Praca zadania poza mierzonymi przebiegami; runs == nullptr - pomiary kolejne
+    class Job {
+    public:
+        explicit Job(ConcurrentRuns* runs) : runs(runs) {
+            if (!runs || !runs->isolate) return;
+            std::unique_lock<std::mutex> guard(runs->lock);
+            runs->changed.wait(guard, [this] { return !this->runs->timing && this->runs->waiting == 0; });
+            ++runs->working;
+        }
+
+        ~Job() {
+            if (!runs || !runs->isolate) return;
+            std::lock_guard<std::mutex> guard(runs->lock);
+            if (--runs->working == 0) runs->changed.notify_all();
+        }
+
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+    private:
+        ConcurrentRuns* runs;
+    };
+
+    // Jeden mierzony przebieg, wywolywany z wnetrza Job; finish() zwraca liczbe nakladajacych sie przebiegow
+    class Timed {
+    public:
+        explicit Timed(ConcurrentRuns* runs) : runs(runs) {
+            if (!runs) return;
+            std::unique_lock<std::mutex> guard(runs->lock);
+            if (runs->isolate) {
+                --runs->working;
+                ++runs->waiting;
+                runs->changed.wait(guard, [this] { return !this->runs->timing && this->runs->working == 0; });
+                --runs->waiting;
+                runs->timing = true;
+            }
+            activeAtStart = runs->active++;
+            startMark = ++runs->started;
+        }
+
+        ~Timed() { finish(); }
+
+        long long finish() {
+            if (!runs) return 0;
+            std::lock_guard<std::mutex> guard(runs->lock);
+            --runs->active;
+            long long overlapping = activeAtStart + (runs->started - startMark);
+            if (runs->isolate) {
+                runs->timing = false;
+                ++runs->working;
+                runs->changed.notify_all();
+            }
+            runs = nullptr;
+            return overlapping;
+        }
+
+        Timed(const Timed&) = delete;
+        Timed& operator=(const Timed&) = delete;
+
+    private:
+        ConcurrentRuns* runs;
+        long long activeAtStart = 0, startMark = 0;
+    };
+
+private:
+    const bool isolate;
+    std::mutex lock;
+    std::condition_variable changed;
+    long long active = 0, started = 0;
+    int working = 0, waiting = 0;
+    bool timing = false;
+};
+
+// Mediana interpolowana, p95 metoda najblizszej rangi, odchylenie standardowe z proby (n - 1)
+SampleStats summarize(std::vector<long long> samples) {
+    SampleStats s;
+    s.count = samples.size();
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    s.minNs = static_cast<double>(samples.front());
+    s.medianNs = n % 2 ? static_cast<double>(samples[n / 2]) : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    s.meanNs = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+    size_t rank = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(n)));
+    s.p95Ns = static_cast<double>(samples[std::max<size_t>(rank, 1) - 1]);
+    double squares = 0;
+    for (long long x : samples) squares += (x - s.meanNs) * (x - s.meanNs);
+    s.stddevNs = n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0.0;
+    return s;
+}
+
+// Rozgrzewka i seria pomiarow jednego wywolania; fn zwraca wartosc kontrolna wyniku.
+// Alokacje liczone sa wokol kazdego mierzonego przebiegu (poza czasem z Timer); z runs (--jobs > 1) tylko
+// alokacje watku pomiaru, a nakladajace sie przebiegi innych zadan dopisywane sa do res.overlaps.
+// Z profilerem liczniki odczytywane sa wokol kazdego mierzonego przebiegu (poza czasem z Timer),
+// a fazy zgloszone przez algorytm dopisywane sa do res.phases.
+template <typename Fn>
+long long measure(const BenchmarkConfig& config, BenchmarkResult& res, PhaseProfiler* profiler, Fn&& fn,
+    ConcurrentRuns* runs = nullptr) {
+    volatile long long sink = 0;
+    for (int i = 0; i < config.warmup; ++i) sink = fn();
+    long long spentNs = 0;
+    const long long budgetNs = static_cast<long long>(config.budgetMs * 1e6);
+    for (int i = 0;; ++i) {
+        ConcurrentRuns::Timed timed(runs);
+        CounterValues before{};
+        if (profiler) {
+            PhaseProfiler::active() = profiler;
+            before = profiler->readCounters();
+        }
+        long long allocationsBefore = runs ? threadAllocationCount() : allocationCount();
+        Timer timer;
+        timer.start();
+        sink = fn();
+        timer.stop();
+        res.allocations += (runs ? threadAllocationCount() : allocationCount()) - allocationsBefore;
+        res.overlaps += timed.finish();
+        if (profiler) {
+            CounterValues after = profiler->readCounters();
+            PhaseProfiler::active() = nullptr;
+            for (size_t c = 0; c < COUNTER_EVENTS; ++c) res.counters[c] += after[c] - before[c];
+            for (const std::pair<const std::string, PhaseTotals>& phase : profiler->take()) {
+                PhaseResult& pr = res.phases[phase.first];
+                pr.samplesNs.push_back(phase.second.ns);
+                for (size_t c = 0; c < COUNTER_EVENTS; ++c) pr.counters[c] += phase.second.counters[c];
+            }
+        }
+        res.samplesNs.push_back(timer.resultNs());
+        spentNs += res.samplesNs.back();
+        if (budgetNs > 0 ? spentNs >= budgetNs : i + 1 >= config.repeats) break;
+    }
+    return sink;
+}
+
+// Dijkstra z --search odpowiada na zapytania punkt-punkt na przygotowaniu budowanym raz dla grafu
+bool isPointToPoint(const TestCase& tc) {
+    return tc.algorithm == GraphAlgorithmType::DIJKSTRA && tc.options.search != PathSearch::FULL;
+}
+
+// Pary (zrodlo, cel) mierzone na grafie z losowania trial: najpierw 0 -> V-1 (zrodlo i ujscie pozostalych
+// przypadkow), pozostale losowe ze strumienia roznego od strumieni generatora
+std::vector<std::pair<int, int>> queryPairs(const BenchmarkConfig& config, int trial) {
+    std::vector<std::pair<int, int>> pairs{ { 0, config.vertices - 1 } };
+    RandomStream rng(trialSeed(config.generator.seed, trial), GENERATOR_BLOCKS + 2);
+    const uint64_t n = static_cast<uint64_t>(std::max(config.vertices, 1));
+    for (int k = 1; k < config.pairs; ++k)
+        pairs.emplace_back(static_cast<int>(rng.below(n)), static_cast<int>(rng.below(n)));
+    return pairs;
+}
+
+// Pomiar przypadku na grafie g. Przypadki punkt-punkt: przygotowanie (graf odwrotny, punkty orientacyjne)
+// budowane raz poza pomiarem, przebieg to wszystkie pary, a probki, alokacje i liczniki przeliczane sa
+// na jedno zapytanie; koszt przygotowania mierzy osobny wiersz "Index[...]". Pozostale przypadki - runAlgorithm
+// dla pierwszej pary.
+template <typename G>
+long long measureCase(const BenchmarkConfig& config, BenchmarkResult& res, PhaseProfiler* profiler, const G& g, const TestCase& tc,
+    const std::vector<std::pair<int, int>>& pairs, AlgorithmWorkspace* workspace, ConcurrentRuns* runs = nullptr) {
+    if (!isPointToPoint(tc)) {
+        return measure(config, res, profiler,
+            [&] { return runAlgorithm(g, tc.algorithm, tc.options, pairs[0].first, pairs[0].second, workspace); }, runs);
+    }
+    const PathSearchIndex index = buildPathSearchIndex(g, tc.options);
+    const size_t first = res.samplesNs.size();
+    const long long allocationsBefore = res.allocations;
+    const CounterValues countersBefore = res.counters;
+    long long digest = measure(config, res, profiler, [&] {
+        long long sum = 0;
+        for (const std::pair<int, int>& q : pairs) sum += runPointToPoint(g, index, q.first, q.second, tc.options).cost;
+        return sum;
+    }, runs);
+    const long long queries = static_cast<long long>(pairs.size());
+    for (size_t k = first; k < res.samplesNs.size(); ++k) res.samplesNs[k] /= queries;
+    res.allocations = allocationsBefore + (res.allocations - allocationsBefore) / queries;
+    for (size_t c = 0; c < COUNTER_EVENTS; ++c) res.counters[c] = countersBefore[c] + (res.counters[c] - countersBefore[c]) / queries;
+    return digest;
+}
+
+// Skladnik grafu wspolny dla zadan --test: budowany przy pierwszym uzyciu (w watku zadania, poza pomiarem)
+// i zwalniany po zakonczeniu ostatniego zadania, ktore go zadeklarowalo; pomiedzy tymi chwilami tylko do odczytu
+template <typename T>
+class SharedPart {
+public:
+    void addUser() { users.fetch_add(1, std::memory_order_relaxed); }
+
+    template <typename Build>
+    const T& get(Build&& build) {
+        std::call_once(once, [&] { value.emplace(build()); });
+        return *value;
+    }
+
+    void release() {
+        if (users.fetch_sub(1, std::memory_order_acq_rel) == 1) value.reset();
+    }
+
+private:
+    std::once_flag once;
+    std::optional<T> value;
+    std::atomic<int> users{ 0 };
+};
+
+// Grafy jednego losowania: lista krawedzi, przenumerowanie oraz reprezentacje grafu wejsciowego (stages[0])
+// i przenumerowanego (stages[1]); stages[0].csr sluzy tez do przenumerowania i kopii w typach
+struct BenchmarkTrial {
+    struct Stage {
+        SharedPart<Graph> list, matrix;
+        SharedPart<CSRGraph> csr;
+    };
+    SharedPart<std::vector<Edge>> edges;
+    SharedPart<std::pair<VertexPermutation, std::vector<Edge>>> relabeled;
+    Stage stages[2];
+};
+
+enum class BenchmarkJobKind { CASE, TYPED, REORDER, INDEX };
+
+// Jeden pomiar --test (rozgrzewka i seria przebiegow) na grafie z jednego losowania
+struct BenchmarkJob {
+    BenchmarkJobKind kind;
+    int graph;
+    size_t stage;    // CASE: 0 - graf wejsciowy, 1 - przenumerowany
+    size_t repr;     // CASE, INDEX: indeks reprezentacji
+    size_t index;    // CASE, INDEX: przypadek, TYPED: pozycja w przypadkach typowanych
+    size_t target;   // wiersz wynikow
+};
+
+// Wszystkie przypadki na wszystkich reprezentacjach. Grafy (rowniez CSR) budowane sa z tej samej listy
+// krawedzi poza mierzonym obszarem; algorytm dostaje graf przez referencje, bez kopii.
+// Z config.reorder kazdy przypadek mierzony jest drugi raz ("nazwa@porzadek") na przenumerowanym grafie,
+// dla tych samych wierzcholkow zrodla i ujscia; koszt przenumerowania to osobny wiersz "Reorder[...]".
+// Z config.types przypadki majace wersje typowana (hasTypedVariant) mierzone sa jeszcze na BasicCSRGraph
+// ("nazwa<typy>", na koncu wynikow); kopia grafu w typach powstaje poza pomiarem.
+// Przypadki punkt-punkt (measureCase) mierza config.pairs zapytan na przygotowaniu zbudowanym raz dla grafu;
+// budowe przygotowania mierza wiersze "Index[wariant]" kazdej reprezentacji (za wersjami typowanymi).
+// Pomiary to niezalezne zadania (BenchmarkJob) wykonywane przez config.jobs watkow z podbieraniem pracy;
+// grafy losowania sa wspolne i tylko do odczytu. Probki trafiaja do wynikow w kolejnosci zadan (graf, etap,
+// reprezentacja, przypadek), wiec plik wynikowy ma ten sam uklad przy kazdej liczbie watkow.
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkConfig& config, const std::vector<TestCase>& cases) {
+    const GraphRepresentation reprs[] = { GraphRepresentation::LIST, GraphRepresentation::MATRIX, GraphRepresentation::CSR };
+    const bool reordered = config.reorder != VertexOrder::NONE;
+    const size_t perRepr = cases.size() * (reordered ? 2 : 1);
+    std::vector<BenchmarkResult> results;
+    for (GraphRepresentation repr : reprs) {
+        for (const TestCase& tc : cases)
+            results.push_back({ repr, tc.name, {}, 0, {}, {}, {}, {} });
+        if (!reordered) continue;
+        for (const TestCase& tc : cases)
+            results.push_back({ repr, tc.name + "@" + vertexOrderName(config.reorder), {}, 0, {}, {}, {}, {} });
+    }
+    const size_t reorderRow = results.size();
+    if (reordered)
+        results.push_back({ GraphRepresentation::CSR, "Reorder[" + vertexOrderName(config.reorder) + "]", {}, 0, {}, {}, {}, {} });
+    std::vector<size_t> typedCases;
+    if (config.types != GraphTypes::INT)
+        for (size_t j = 0; j < cases.size(); ++j)
+            if (hasTypedVariant(cases[j].algorithm, cases[j].options)) typedCases.push_back(j);
+    const size_t typedOffset = results.size();
+    for (size_t j : typedCases)
+        results.push_back({ GraphRepresentation::CSR, cases[j].name + "<" + graphTypesName(config.types) + ">", {}, 0, {}, {}, {}, {} });
+    std::vector<size_t> indexedCases;
+    for (size_t j = 0; j < cases.size(); ++j)
+        if (isPointToPoint(cases[j]) && needsPathSearchIndex(cases[j].options)) indexedCases.push_back(j);
+    const size_t indexOffset = results.size();
+    for (GraphRepresentation repr : reprs)
+        for (size_t j : indexedCases)
+            results.push_back({ repr, "Index[" + pathSearchName(cases[j].options.search) + "]", {}, 0, {}, {}, {}, {} });
+
+    {
+        PerfCounters probe;
+        if (config.counters && !probe.available())
+            std::cout << "Liczniki sprzetowe niedostepne (perf_event_open) - zapisywane beda tylko czasy faz\n";
+        for (BenchmarkResult& res : results)
+            for (size_t c = 0; c < COUNTER_EVENTS; ++c) res.counterAvailable[c] = config.counters && probe.available(c);
+    }
+
+    std::vector<BenchmarkJob> jobs;
+    for (int i = 0; i < config.graphs; ++i) {
+        for (size_t r = 0; r < std::size(reprs); ++r)
+            for (size_t j = 0; j < cases.size(); ++j)
+                jobs.push_back({ BenchmarkJobKind::CASE, i, 0, r, j, r * perRepr + j });
+        for (size_t k = 0; k < typedCases.size(); ++k)
+            jobs.push_back({ BenchmarkJobKind::TYPED, i, 0, 0, k, typedOffset + k });
+        for (size_t r = 0; r < std::size(reprs); ++r)
+            for (size_t k = 0; k < indexedCases.size(); ++k)
+                jobs.push_back({ BenchmarkJobKind::INDEX, i, 0, r, indexedCases[k], indexOffset + r * indexedCases.size() + k });
+        if (!reordered) continue;
+        jobs.push_back({ BenchmarkJobKind::REORDER, i, 0, 0, 0, reorderRow });
+        for (size_t r = 0; r < std::size(reprs); ++r)
+            for (size_t j = 0; j < cases.size(); ++j)
+                jobs.push_back({ BenchmarkJobKind::CASE, i, 1, r, j, r * perRepr + cases.size() + j });
+    }
+
+    // Skladniki grafow potrzebne zadaniu (rowniez posrednio, do zbudowania tych, ktorych uzywa)
+    std::vector<BenchmarkTrial> trials(config.graphs);
+    auto forEachPart = [&](const BenchmarkJob& job, auto&& visit) {
+        BenchmarkTrial& trial = trials[job.graph];
+        visit(trial.edges);
+        bool onGraph = job.kind == BenchmarkJobKind::CASE || job.kind == BenchmarkJobKind::INDEX;
+        bool csrCase = reprs[job.repr] == GraphRepresentation::CSR;
+        if (!onGraph || job.stage == 1 || csrCase) visit(trial.stages[0].csr);
+        if (!onGraph) return;
+        if (job.stage == 1) visit(trial.relabeled);
+        BenchmarkTrial::Stage& stage = trial.stages[job.stage];
+        if (reprs[job.repr] == GraphRepresentation::LIST) visit(stage.list);
+        else if (reprs[job.repr] == GraphRepresentation::MATRIX) visit(stage.matrix);
+        else if (job.stage == 1) visit(stage.csr);
+    };
+    for (const BenchmarkJob& job : jobs) forEachPart(job, [](auto& part) { part.addUser(); });
+
+    auto edgesOf = [&](int i) -> const std::vector<Edge>& {
+        return trials[i].edges.get([&] {
+            GeneratorOptions gen = config.generator;
+            gen.seed = trialSeed(config.generator.seed, i);
+            return generateEdges(config.vertices, config.density, config.directed, gen);
+        });
+    };
+    auto inputCSR = [&](int i) -> const CSRGraph& {
+        return trials[i].stages[0].csr.get([&] { return CSRGraph(config.vertices, config.directed, edgesOf(i)); });
+    };
+    auto relabeledOf = [&](int i) -> const std::pair<VertexPermutation, std::vector<Edge>>& {
+        return trials[i].relabeled.get([&] {
+            VertexPermutation perm = computeVertexOrder(inputCSR(i), config.reorder);
+            std::vector<Edge> relabeled = relabelEdges(edgesOf(i), perm);
+            return std::make_pair(std::move(perm), std::move(relabeled));
+        });
+    };
+    auto graphOf = [&](int i, size_t stage, GraphRepresentation repr) -> const Graph& {
+        SharedPart<Graph>& part = repr == GraphRepresentation::MATRIX ? trials[i].stages[stage].matrix : trials[i].stages[stage].list;
+        return part.get([&] {
+            Graph g(config.vertices, config.directed, repr);
+            g.setEdges(std::vector<Edge>(stage ? relabeledOf(i).second : edgesOf(i)));
+            return g;
+        });
+    };
+    auto csrOf = [&](int i, size_t stage) -> const CSRGraph& {
+        if (stage == 0) return inputCSR(i);
+        return trials[i].stages[1].csr.get([&] { return CSRGraph(config.vertices, config.directed, relabeledOf(i).second); });
+    };
+
+    // Liczniki i profiler otwierane w watku, ktory z nich korzysta (perf_event_open liczy watek otwierajacy)
+    const unsigned workers = std::max(1u, config.jobs);
+    std::vector<std::unique_ptr<PerfCounters>> workerCounters(workers);
+    std::vector<std::unique_ptr<PhaseProfiler>> profilers(workers);
+    auto profilerFor = [&](unsigned worker) -> PhaseProfiler* {
+        if (!config.counters) return nullptr;
+        if (!profilers[worker]) {
+            workerCounters[worker] = std::make_unique<PerfCounters>();
+            profilers[worker] = std::make_unique<PhaseProfiler>(workerCounters[worker].get());
+        }
+        return profilers[worker].get();
+    };
+    std::optional<ConcurrentRuns> concurrent;
+    if (workers > 1) concurrent.emplace(config.isolate);
+    ConcurrentRuns* runs = concurrent ? &*concurrent : nullptr;
+    std::mutex printLock;
+
+    std::vector<BenchmarkResult> partial(jobs.size());
+    parallelForStealing(jobs.size(), workers, [&](size_t k, unsigned worker) {
+        const BenchmarkJob& job = jobs[k];
+        const int i = job.graph;
+        BenchmarkResult& res = partial[k];
+        PhaseProfiler* profiler = profilerFor(worker);
+        ConcurrentRuns::Job section(runs);
+        auto progress = [&](const std::string& what) {
+            std::lock_guard<std::mutex> guard(printLock);
+            std::cout << "Graf " << i + 1 << "/" << config.graphs << " | " << what << "\n";
+        };
+        if (job.kind == BenchmarkJobKind::CASE) {
+            const TestCase& tc = cases[job.index];
+            if (job.index == 0)
+                progress(representationName(reprs[job.repr]) + (job.stage ? " | " + vertexOrderName(config.reorder) : ""));
+            // te same wierzcholki na grafie przenumerowanym
+            std::vector<std::pair<int, int>> pairs = queryPairs(config, i);
+            if (job.stage)
+                for (std::pair<int, int>& q : pairs) q = { relabeledOf(i).first.newId(q.first), relabeledOf(i).first.newId(q.second) };
+            // workspace tworzony dla przypadku raz - rozgrzewka ustala rozmiary buforow
+            AlgorithmWorkspace ws;
+            AlgorithmWorkspace* workspace = config.workspace ? &ws : nullptr;
+            if (reprs[job.repr] == GraphRepresentation::CSR)
+                res.digest = measureCase(config, res, profiler, csrOf(i, job.stage), tc, pairs, workspace, runs);
+            else
+                res.digest = measureCase(config, res, profiler, graphOf(i, job.stage, reprs[job.repr]), tc, pairs, workspace, runs);
+        }
+        else if (job.kind == BenchmarkJobKind::INDEX) {
+            // Budowa przygotowania zapytan punkt-punkt; wartosc kontrolna - liczba punktow orientacyjnych
+            const TestCase& tc = cases[job.index];
+            auto build = [&](const auto& g) {
+                return measure(config, res, profiler, [&] {
+                    PathSearchIndex index = buildPathSearchIndex(g, tc.options);
+                    return static_cast<long long>(index.landmarks ? index.landmarks->count : 0);
+                }, runs);
+            };
+            if (reprs[job.repr] == GraphRepresentation::CSR) res.digest = build(csrOf(i, 0));
+            else res.digest = build(graphOf(i, 0, reprs[job.repr]));
+        }
+        else if (job.kind == BenchmarkJobKind::TYPED) {
+            // AUTO rozstrzygane na kazdym grafie; przy tych samych parametrach generatora wynik jest ten sam
+            const CSRGraph& input = inputCSR(i);
+            GraphTypes types = resolveGraphTypes(config.types, input);
+            if (job.index == 0) progress("CSR " + graphTypesName(types));
+            const TestCase& tc = cases[typedCases[job.index]];
+            res.name = tc.name + "<" + graphTypesName(types) + ">";
+            dispatchGraphTypes(types, [&](auto tag) {
+                using A = typename decltype(tag)::type;
+                typename A::CSR typed(input);
+                res.digest = measure(config, res, profiler,
+                    [&] { return runTypedAlgorithm<A>(typed, tc.algorithm, 0, config.vertices - 1); }, runs);
+            });
+        }
+        else {
+            // Koszt przenumerowania: permutacja liczona na CSR i lista krawedzi z nowymi numerami
+            const CSRGraph& input = inputCSR(i);
+            const std::vector<Edge>& edges = edgesOf(i);
+            VertexPermutation perm;
+            std::vector<Edge> relabeled;
+            res.digest = measure(config, res, profiler, [&] {
+                perm = computeVertexOrder(input, config.reorder);
+                relabeled = relabelEdges(edges, perm);
+                return static_cast<long long>(perm.toOld.empty() ? 0 : perm.toOld.front());
+            }, runs);
+        }
+        forEachPart(job, [](auto& part) { part.release(); });
+    }, config.pin);
+
+    for (size_t k = 0; k < jobs.size(); ++k) {
+        BenchmarkResult& res = results[jobs[k].target];
+        BenchmarkResult& part = partial[k];
+        if (!part.name.empty()) res.name = part.name;
+        res.samplesNs.insert(res.samplesNs.end(), part.samplesNs.begin(), part.samplesNs.end());
+        res.digest = part.digest;
+        res.allocations += part.allocations;
+        res.overlaps += part.overlaps;
+        for (size_t c = 0; c < COUNTER_EVENTS; ++c) res.counters[c] += part.counters[c];
+        for (std::pair<const std::string, PhaseResult>& phase : part.phases) {
+            PhaseResult& pr = res.phases[phase.first];
+            pr.samplesNs.insert(pr.samplesNs.end(), phase.second.samplesNs.begin(), phase.second.samplesNs.end());
+            for (size_t c = 0; c < COUNTER_EVENTS; ++c) pr.counters[c] += phase.second.counters[c];
+        }
+    }
+
+    for (BenchmarkResult& res : results) {
+        res.stats = summarize(res.samplesNs);
+        for (std::pair<const std::string, PhaseResult>& phase : res.phases) phase.second.stats = summarize(phase.second.samplesNs);
+    }
+    if (reordered) {
+        for (size_t r = 0; r < std::size(reprs); ++r) {
+            for (size_t j = 0; j < cases.size(); ++j) {
+                BenchmarkResult& after = results[r * perRepr + cases.size() + j];
+                const BenchmarkResult& before = results[r * perRepr + j];
+                if (after.stats.medianNs > 0) after.speedup = before.stats.medianNs / after.stats.medianNs;
+            }
+        }
+    }
+    // serie --threads na grafie wejsciowym: wzgledem przypadku z pierwsza liczba watkow
+    for (size_t r = 0; r < std::size(reprs); ++r) {
+        for (size_t j = 0; j < cases.size(); ++j) {
+            if (cases[j].scalingBase < 0) continue;
+            const TestCase& baseCase = cases[cases[j].scalingBase];
+            BenchmarkResult& res = results[r * perRepr + j];
+            const BenchmarkResult& base = results[r * perRepr + cases[j].scalingBase];
+            if (res.stats.medianNs <= 0) continue;
+            res.speedup = base.stats.medianNs / res.stats.medianNs;
+            res.efficiency = res.speedup * baseCase.options.threads / cases[j].options.threads;
+        }
+    }
+    // wersje typowane wzgledem tego samego przypadku na CSR z int
+    const size_t csrBase = (std::size(reprs) - 1) * perRepr;
+    for (size_t k = 0; k < typedCases.size(); ++k) {
+        BenchmarkResult& typed = results[typedOffset + k];
+        const BenchmarkResult& base = results[csrBase + typedCases[k]];
+        if (typed.stats.medianNs > 0) typed.speedup = base.stats.medianNs / typed.stats.medianNs;
+    }
+    return results;
+}
+
+double allocationsPerRun(const BenchmarkResult& res) {
+    return res.stats.count ? static_cast<double>(res.allocations) / static_cast<double>(res.stats.count) : 0.0;
+}
+
+// Srednia liczba mierzonych przebiegow innych zadan nakladajacych sie na jeden przebieg (0 - pomiar bez zaklocen)
+double overlapPerRun(const BenchmarkResult& res) {
+    return res.stats.count ? static_cast<double>(res.overlaps) / static_cast<double>(res.stats.count) : 0.0;
+}
+
+// Srednia wartosc licznika na jeden przebieg; -1, gdy zdarzenie jest niedostepne lub liczniki wylaczone
+long long counterPerRun(const BenchmarkResult& res, const CounterValues& totals, size_t event, size_t runs) {
+    if (!res.counterAvailable[event] || runs == 0) return -1;
+    return std::llround(static_cast<double>(totals[event]) / static_cast<double>(runs));
+}
+
+// Czasy w plikach zaokraglane do pelnych nanosekund
+// CSV w postaci "tidy": jeden wiersz na przypadek i reprezentacje (phase = total) oraz po jednym na kazda
+// faze algorytmu, parametry przebiegu w kazdym wierszu; puste pole licznika - zdarzenie niedostepne
+void writeBenchmarkCsv(std::ostream& out, const BenchmarkConfig& config, const std::vector<BenchmarkResult>& results) {
+    out << "representation,algorithm,phase,vertices,density,model,seed,graphs,warmup,samples,min_ns,median_ns,mean_ns,p95_ns,stddev_ns,digest,speedup,efficiency,allocs_per_run,overlap_per_run";
+    for (size_t c = 0; c < COUNTER_EVENTS; ++c) out << "," << counterName(c);
+    out << "\n";
+    auto row = [&](const BenchmarkResult& res, const std::string& phase, const SampleStats& stats, const CounterValues& counters) {
+        out << representationName(res.representation) << "," << res.name << "," << phase << "," << config.vertices << ","
+            << config.density << "," << graphModelName(config.generator.model) << "," << config.generator.seed << ","
+            << config.graphs << "," << config.warmup << "," << stats.count << ","
+            << std::llround(stats.minNs) << "," << std::llround(stats.medianNs) << "," << std::llround(stats.meanNs) << ","
+            << std::llround(stats.p95Ns) << "," << std::llround(stats.stddevNs) << "," << res.digest << ",";
+        if (res.speedup > 0 && phase == "total") out << res.speedup;
+        out << ",";
+        if (res.efficiency > 0 && phase == "total") out << res.efficiency;
+        out << ",";
+        if (phase == "total") out << allocationsPerRun(res);
+        out << ",";
+        if (phase == "total") out << overlapPerRun(res);
+        for (size_t c = 0; c < COUNTER_EVENTS; ++c) {
+            long long value = counterPerRun(res, counters, c, stats.count);
+            out << ",";
+            if (value >= 0) out << value;
+        }
+        out << "\n";
+    };
+    for (const BenchmarkResult& res : results) {
+        row(res, "total", res.stats, res.counters);
+        for (const std::pair<const std::string, PhaseResult>& phase : res.phases)
+            row(res, phase.first, phase.second.stats, phase.second.counters);
+    }
+}
+
+std::string jsonString(const std::string& s) {
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// Liczniki na przebieg jako obiekt JSON; null dla niedostepnych zdarzen
+std::string jsonCounters(const BenchmarkResult& res, const CounterValues& totals, size_t runs) {
+    std::string json = "{";
+    for (size_t c = 0; c < COUNTER_EVENTS; ++c) {
+        long long value = counterPerRun(res, totals, c, runs);
+        json += (c ? ", " : "") + jsonString(counterName(c)) + ": " + (value >= 0 ? std::to_string(value) : "null");
+    }
+    return json + "}";
+}
+
+// JSON: parametry przebiegu, statystyki, liczniki, fazy i surowe probki kazdego przypadku
+void writeBenchmarkJson(std::ostream& out, const BenchmarkConfig& config, const std::vector<BenchmarkResult>& results) {
+    out << "{\n  \"config\": {\"vertices\": " << config.vertices << ", \"density\": " << config.density
+        << ", \"model\": " << jsonString(graphModelName(config.generator.model)) << ", \"seed\": " << config.generator.seed
+        << ", \"graphs\": " << config.graphs << ", \"warmup\": " << config.warmup << ", \"repeats\": " << config.repeats
+        << ", \"budget_ms\": " << config.budgetMs << ", \"reorder\": " << jsonString(vertexOrderName(config.reorder))
+        << ", \"workspace\": " << (config.workspace ? "true" : "false")
+        << ", \"jobs\": " << config.jobs << ", \"isolate\": " << (config.isolate ? "true" : "false")
+        << ", \"pairs\": " << config.pairs
+        << ", \"types\": " << jsonString(graphTypesName(config.types))
+        << ", \"simd\": " << jsonString(simdLevelName(simd().level))
+        << "},\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& res = results[i];
+        out << "    {\"representation\": " << jsonString(representationName(res.representation))
+            << ", \"algorithm\": " << jsonString(res.name) << ", \"samples\": " << res.stats.count
+            << ", \"min_ns\": " << std::llround(res.stats.minNs) << ", \"median_ns\": " << std::llround(res.stats.medianNs)
+            << ", \"mean_ns\": " << std::llround(res.stats.meanNs) << ", \"p95_ns\": " << std::llround(res.stats.p95Ns)
+            << ", \"stddev_ns\": " << std::llround(res.stats.stddevNs) << ", \"digest\": " << res.digest
+            << ", \"speedup\": " << (res.speedup > 0 ? std::to_string(res.speedup) : "null")
+            << ", \"efficiency\": " << (res.efficiency > 0 ? std::to_string(res.efficiency) : "null")
+            << ", \"allocations_per_run\": " << allocationsPerRun(res)
+            << ", \"overlap_per_run\": " << overlapPerRun(res)
+            << ", \"counters\": " << jsonCounters(res, res.counters, res.stats.count) << ", \"phases\": {";
+        bool firstPhase = true;
+        for (const std::pair<const std::string, PhaseResult>& phase : res.phases) {
+            const SampleStats& ps = phase.second.stats;
+            out << (firstPhase ? "" : ", ") << jsonString(phase.first) << ": {\"median_ns\": " << std::llround(ps.medianNs)
+                << ", \"mean_ns\": " << std::llround(ps.meanNs) << ", \"counters\": "
+                << jsonCounters(res, phase.second.counters, ps.count) << "}";
+            firstPhase = false;
+        }
+        out << "}, \"samples_ns\": [";
+        for (size_t k = 0; k < res.samplesNs.size(); ++k) out << (k ? ", " : "") << res.samplesNs[k];
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Krotkie podsumowanie na ekran (mediana i p95 w milisekundach, alokacje na przebieg, przyspieszenie wzgledem wersji bazowej,
+// w seriach --threads rowniez wydajnosc skalowania, przy --jobs srednia liczba nakladajacych sie pomiarow)
+void printBenchmarkSummary(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << std::left << std::setw(8) << "repr" << std::setw(28) << "algorytm" << std::right
+        << std::setw(14) << "mediana[ms]" << std::setw(14) << "p95[ms]" << std::setw(14) << "odch.[ms]"
+        << std::setw(14) << "alok./przeb." << "\n";
+    out << std::fixed << std::setprecision(4);
+    for (const BenchmarkResult& res : results) {
+        out << std::left << std::setw(8) << representationName(res.representation) << std::setw(28) << res.name << std::right
+            << std::setw(14) << res.stats.medianNs / 1e6 << std::setw(14) << res.stats.p95Ns / 1e6
+            << std::setw(14) << res.stats.stddevNs / 1e6 << std::setw(14) << std::setprecision(1) << allocationsPerRun(res)
+            << std::setprecision(4);
+        if (res.speedup > 0) out << std::setw(10) << std::setprecision(2) << res.speedup << "x" << std::setprecision(4);
+        if (res.efficiency > 0) out << std::setw(8) << std::setprecision(0) << res.efficiency * 100 << "%" << std::setprecision(4);
+        if (res.overlaps > 0) out << std::setw(8) << std::setprecision(1) << overlapPerRun(res) << " nakl." << std::setprecision(4);
+        out << "\n";
+        for (const std::pair<const std::string, PhaseResult>& phase : res.phases) {
+            out << std::left << std::setw(8) << "" << std::setw(28) << ("  " + phase.first) << std::right
+                << std::setw(14) << phase.second.stats.medianNs / 1e6 << std::setw(14) << phase.second.stats.p95Ns / 1e6
+                << std::setw(14) << phase.second.stats.stddevNs / 1e6 << "\n";
+        }
+    }
+}
+
+// --dynamic: partie losowych zmian krawedzi stosowane do DynamicGraph i, dla porownania, pelne przeliczenie
+// wyniku na grafie po zmianie (Kruskal albo Dijkstra; budowa Graph poza pomiarem). Po kazdej partii oba wyniki
+// sa porownywane - rozbieznosc przerywa pomiar wyjatkiem.
+struct DynamicBenchmarkConfig {
+    int problem = 0;         // 0 - MST (graf nieskierowany), 1 - najkrotsze sciezki z wierzcholka 0 (graf skierowany)
+    int vertices = 0;
+    double density = 0;
+    int batches = 20;
+    int batchSize = 10;      // zmian w partii
+    GeneratorOptions generator;
+};
+
+struct DynamicBatchResult {
+    long long updateNs = 0;
+    long long recomputeNs = 0;
+    UpdateStats stats;
+};
+
+std::vector<DynamicBatchResult> runDynamicBenchmark(const DynamicBenchmarkConfig& config) {
+    const bool directed = config.problem != 0;
+    DynamicGraph dynamic(config.vertices, directed, generateEdges(config.vertices, config.density, directed, config.generator));
+    if (config.problem == 0) dynamic.maintainMST();
+    else dynamic.maintainShortestPaths(0);
+    RandomStream rng(config.generator.seed, GENERATOR_BLOCKS);  // strumien rozny od strumieni generatora
+
+    std::vector<DynamicBatchResult> results;
+    for (int b = 0; b < config.batches; ++b) {
+        std::vector<EdgeUpdate> batch = randomEdgeUpdates(dynamic, config.batchSize,
+            config.generator.minWeight, config.generator.maxWeight, rng);
+        DynamicBatchResult res;
+        Timer timer;
+        timer.start();
+        res.stats = dynamic.apply(batch);
+        timer.stop();
+        res.updateNs = timer.resultNs();
+
+        Graph g(config.vertices, directed);
+        g.setEdges(dynamic.edges());
+        timer.start();
+        if (config.problem == 0) {
+            long long weight = totalWeight(GraphAlgorithms::kruskalMST(g));
+            timer.stop();
+            if (weight != dynamic.mstWeight()) throw std::runtime_error("Dynamic MST differs from recomputed MST");
+        }
+        else {
+            std::vector<int> dist = GraphAlgorithms::dijkstra(g, 0).first;
+            timer.stop();
+            if (dist != dynamic.dist()) throw std::runtime_error("Dynamic distances differ from recomputed distances");
+        }
+        res.recomputeNs = timer.resultNs();
+        results.push_back(res);
+    }
+    return results;
+}
+
+void writeDynamicCsv(std::ostream& out, const DynamicBenchmarkConfig& config, const std::vector<DynamicBatchResult>& results) {
+    out << "problem,vertices,density,model,seed,batch,batch_size,update_ns,recompute_ns,mst_replacements,affected_vertices,settled_vertices\n";
+    for (size_t b = 0; b < results.size(); ++b) {
+        const DynamicBatchResult& res = results[b];
+        out << config.problem << "," << config.vertices << "," << config.density << "," << graphModelName(config.generator.model) << ","
+            << config.generator.seed << "," << b << "," << config.batchSize << "," << res.updateNs << "," << res.recomputeNs << ","
+            << res.stats.mstReplacements << "," << res.stats.affectedVertices << "," << res.stats.settledVertices << "\n";
+    }
+}
+
+// Mediany czasu partii dla obu drog i ich stosunek
+void printDynamicSummary(std::ostream& out, const std::vector<DynamicBatchResult>& results) {
+    std::vector<long long> update, recompute;
+    for (const DynamicBatchResult& res : results) {
+        update.push_back(res.updateNs);
+        recompute.push_back(res.recomputeNs);
+    }
+    SampleStats u = summarize(update), r = summarize(recompute);
+    out << std::fixed << std::setprecision(4);
+    out << "Partie: " << results.size() << "\n";
+    out << "aktualizacja   mediana " << u.medianNs / 1e6 << " ms, p95 " << u.p95Ns / 1e6 << " ms\n";
+    out << "przeliczenie   mediana " << r.medianNs / 1e6 << " ms, p95 " << r.p95Ns / 1e6 << " ms\n";
+    if (u.medianNs > 0) out << "przyspieszenie " << std::setprecision(2) << r.medianNs / u.medianNs << "x\n";
+    out << std::defaultfloat;
+}
+
+// --sweep: siatka liczby wierzcholkow x gestosci w jednym wywolaniu. Kazda komorka (punkt siatki x przypadek
+// x reprezentacja) generowana, budowana i mierzona jest w osobnym procesie potomnym: po przekroczeniu limitu
+// czasu jest zabijana, a jej szczytowa pamiec rezydentna pochodzi z rusage. Proces glowny nie trzyma grafow,
+// wiec RSS potomka to sama komorka (plus kilka MB programu). Po przekroczeniu limitu wieksze V dla tej samej
+// gestosci, przypadku i reprezentacji sa pomijane; wiersze CSV zapisywane sa zaraz po kazdej komorce.
+struct SweepConfig {
+    BenchmarkConfig base;            // grafy, rozgrzewka, powtorzenia/budzet, generator; vertices i density z siatki
+    std::vector<int> vertices;       // rosnaco
+    std::vector<double> densities;   // ulamki z (0, 1]
+    double timeoutMs = 60000;        // limit na komorke (generowanie i budowa grafow, rozgrzewka, pomiary); 0 - bez limitu
+};
+
+enum class SweepStatus { OK, TIMEOUT, SKIPPED, FAILED };
+
+std::string sweepStatusName(SweepStatus status) {
+    switch (status) {
+    case SweepStatus::OK: return "ok";
+    case SweepStatus::TIMEOUT: return "timeout";
+    case SweepStatus::SKIPPED: return "skipped";
+    case SweepStatus::FAILED: return "failed";
+    }
+    return "unknown";
+}
+
+// Bajty zajete przez skladniki reprezentacji (pojemnosc wektorow, z naglowkami list sasiedztwa)
+struct GraphFootprint {
+    long long adjList = 0, matrix = 0, edges = 0, csr = 0;
+};
+
+GraphFootprint graphFootprint(const Graph& g) {
+    GraphFootprint f;
+    f.adjList = static_cast<long long>(g.adjList.capacity() * sizeof(g.adjList[0]));
+    for (const std::vector<std::pair<int, int>>& row : g.adjList) f.adjList += static_cast<long long>(row.capacity() * sizeof(row[0]));
+    f.matrix = static_cast<long long>(g.matrix.bits.capacity() * sizeof(uint64_t) + g.matrix.weights.capacity() * sizeof(int));
+    f.edges = static_cast<long long>(g.edges.capacity() * sizeof(Edge));
+    return f;
+}
+
+GraphFootprint graphFootprint(const CSRGraph& g) {
+    GraphFootprint f;
+    f.csr = static_cast<long long>(g.offsets.size_bytes() + g.targets.size_bytes() + g.weights.size_bytes());
+    return f;
+}
+
+// Wynik komorki przesylany z procesu potomnego przez potok - tylko typy trywialnie kopiowalne
+struct SweepMeasurement {
+    SampleStats stats;
+    long long digest = 0;
+    double allocationsPerRun = 0;
+    GraphFootprint footprint;   // ostatniego grafu punktu
+};
+
+struct SweepResult {
+    int vertices = 0;
+    double density = 0;
+    GraphRepresentation representation;
+    std::string name;
+    SweepStatus status = SweepStatus::OK;
+    double elapsedMs = 0;        // cala komorka, z generowaniem i budowa grafow oraz rozgrzewka
+    long long peakRssKb = -1;    // -1 - niedostepne
+    SweepMeasurement measurement;
+};
+
+// Przypadek na jednej reprezentacji wszystkich grafow punktu siatki (jak runBenchmarks, bez licznikow). Grafy
+// generowane sa tu, po jednym naraz, z tymi samymi ziarnami co w --test
+SweepMeasurement measureSweepCell(const BenchmarkConfig& config, const TestCase& tc, GraphRepresentation repr) {
+    BenchmarkResult res{ repr, tc.name, {}, 0, {}, {}, {}, {} };
+    SweepMeasurement m;
+    for (int i = 0; i < config.graphs; ++i) {
+        GeneratorOptions gen = config.generator;
+        gen.seed = trialSeed(config.generator.seed, i);
+        const std::vector<Edge> edges = generateEdges(config.vertices, config.density, config.directed, gen);
+        const std::vector<std::pair<int, int>> pairs = queryPairs(config, i);
+        AlgorithmWorkspace ws;
+        AlgorithmWorkspace* workspace = config.workspace ? &ws : nullptr;
+        if (repr == GraphRepresentation::CSR) {
+            CSRGraph csr(config.vertices, config.directed, edges);
+            m.footprint = graphFootprint(csr);
+            res.digest = measureCase(config, res, nullptr, csr, tc, pairs, workspace);
+            continue;
+        }
+        Graph g(config.vertices, config.directed, repr);
+        g.setEdges(std::vector<Edge>(edges));
+        m.footprint = graphFootprint(g);
+        res.digest = measureCase(config, res, nullptr, g, tc, pairs, workspace);
+    }
+    res.stats = summarize(res.samplesNs);
+    m.stats = res.stats;
+    m.digest = res.digest;
+    m.allocationsPerRun = allocationsPerRun(res);
+    return m;
+}
+
+// Wykonuje work() (zwraca T) w procesie potomnym i odbiera wynik przez potok; po timeoutMs (> 0) zabija proces.
+// Bez fork (np. Windows) work() wykonywane jest w miejscu, a przekroczenie limitu stwierdzane po fakcie.
+template <typename T, typename Work>
+SweepStatus runCancellable(Work&& work, double timeoutMs, T& result, long long& peakRssKb) {
+    static_assert(std::is_trivially_copyable_v<T>, "Result must be trivially copyable");
+    peakRssKb = -1;
+#ifdef GRAPH_HAS_FORK
+    int fds[2];
+    if (::pipe(fds) != 0) throw std::runtime_error("Cannot create pipe");
+    std::cout.flush();
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::runtime_error("Cannot fork measurement process");
+    }
+    if (pid == 0) {
+        ::close(fds[0]);
+        int code = 0;
+        try {
+            T value = work();
+            const char* p = reinterpret_cast<const char*>(&value);
+            for (size_t sent = 0; sent < sizeof(T);) {
+                ssize_t n = ::write(fds[1], p + sent, sizeof(T) - sent);
+                if (n <= 0) {
+                    code = 2;
+                    break;
+                }
+                sent += static_cast<size_t>(n);
+            }
+        }
+        catch (...) {
+            code = 1;
+        }
+        ::_exit(code);
+    }
+    ::close(fds[1]);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(timeoutMs);
+    char* buffer = reinterpret_cast<char*>(&result);
+    size_t received = 0;
+    bool timedOut = false;
+    while (received < sizeof(T)) {
+        int waitMs = -1;
+        if (timeoutMs > 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            waitMs = static_cast<int>(std::max<long long>(left, 0));
+        }
+        pollfd p{ fds[0], POLLIN, 0 };
+        int ready = ::poll(&p, 1, waitMs);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready == 0) {
+            timedOut = true;
+            ::kill(pid, SIGKILL);
+            break;
+        }
+        ssize_t n = ::read(fds[0], buffer + received, sizeof(T) - received);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;   // proces zakonczyl sie bez pelnego wyniku
+        received += static_cast<size_t>(n);
+    }
+    ::close(fds[0]);
+    int status = 0;
+    rusage usage{};
+    while (::wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {}
+#ifdef __APPLE__
+    peakRssKb = static_cast<long long>(usage.ru_maxrss) / 1024;   // macOS podaje bajty
+#else
+    peakRssKb = static_cast<long long>(usage.ru_maxrss);
+#endif
+    if (timedOut) return SweepStatus::TIMEOUT;
+    if (received != sizeof(T) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) return SweepStatus::FAILED;
+    return SweepStatus::OK;
+#else
+    Timer timer;
+    timer.start();
+    try {
+        result = work();
+    }
+    catch (...) {
+        return SweepStatus::FAILED;
+    }
+    timer.stop();
+    return timeoutMs > 0 && timer.resultNs() > timeoutMs * 1e6 ? SweepStatus::TIMEOUT : SweepStatus::OK;
+#endif
+}
+
+// Jedna tabela "tidy": wiersz na komorke; pola pomiaru puste, gdy status != ok, pamiec reprezentacji w bajtach
+void writeSweepCsvHeader(std::ostream& out) {
+    out << "vertices,density,model,seed,graphs,warmup,representation,algorithm,status,samples,min_ns,median_ns,mean_ns,p95_ns,"
+        << "stddev_ns,digest,allocs_per_run,elapsed_ms,peak_rss_kb,adj_list_bytes,matrix_bytes,edges_bytes,csr_bytes\n";
+}
+
+void writeSweepCsvRow(std::ostream& out, const SweepConfig& config, const SweepResult& res) {
+    const BenchmarkConfig& base = config.base;
+    out << res.vertices << "," << res.density << "," << graphModelName(base.generator.model) << "," << base.generator.seed << ","
+        << base.graphs << "," << base.warmup << "," << representationName(res.representation) << "," << res.name << ","
+        << sweepStatusName(res.status) << ",";
+    if (res.status == SweepStatus::OK) {
+        const SweepMeasurement& m = res.measurement;
+        out << m.stats.count << "," << std::llround(m.stats.minNs) << "," << std::llround(m.stats.medianNs) << ","
+            << std::llround(m.stats.meanNs) << "," << std::llround(m.stats.p95Ns) << "," << std::llround(m.stats.stddevNs) << ","
+            << m.digest << "," << m.allocationsPerRun << ",";
+    }
+    else out << ",,,,,,,,";
+    if (res.status != SweepStatus::SKIPPED) out << res.elapsedMs;
+    out << ",";
+    if (res.peakRssKb >= 0) out << res.peakRssKb;
+    out << ",";
+    if (res.status == SweepStatus::OK) {
+        const GraphFootprint& f = res.measurement.footprint;
+        out << f.adjList << "," << f.matrix << "," << f.edges << "," << f.csr;
+    }
+    else out << ",,,";
+    out << "\n";
+}
+
+// Wyniki komorek w kolejnosci pomiaru; kazda komorka od razu dopisywana do csv (naglowek na poczatku), wiec
+// przerwany przebieg zostawia wszystkie zakonczone wiersze
+std::vector<SweepResult> runSweep(const SweepConfig& config, const std::vector<TestCase>& cases, std::ostream& csv) {
+    const GraphRepresentation reprs[] = { GraphRepresentation::LIST, GraphRepresentation::MATRIX, GraphRepresentation::CSR };
+    const size_t cells = std::size(reprs) * cases.size();
+    // najmniejsze V z przekroczonym limitem dla (gestosc, reprezentacja, przypadek)
+    std::vector<int> timedOutAt(config.densities.size() * cells, std::numeric_limits<int>::max());
+    std::vector<SweepResult> results;
+    auto record = [&](const SweepResult& res) {
+        writeSweepCsvRow(csv, config, res);
+        csv.flush();
+        if (!csv) throw std::runtime_error("Cannot write output file");
+        results.push_back(res);
+    };
+    writeSweepCsvHeader(csv);
+    for (size_t d = 0; d < config.densities.size(); ++d) {
+        for (int vertices : config.vertices) {
+            BenchmarkConfig point = config.base;
+            point.vertices = vertices;
+            point.density = config.densities[d];
+            for (size_t r = 0; r < std::size(reprs); ++r) {
+                for (size_t j = 0; j < cases.size(); ++j) {
+                    SweepResult res;
+                    res.vertices = vertices;
+                    res.density = point.density;
+                    res.representation = reprs[r];
+                    res.name = cases[j].name;
+                    int& limit = timedOutAt[d * cells + r * cases.size() + j];
+                    std::cout << "V=" << vertices << " gestosc=" << point.density * 100 << "% | "
+                        << representationName(reprs[r]) << " | " << res.name << ": ";
+                    if (vertices >= limit) {
+                        res.status = SweepStatus::SKIPPED;
+                        std::cout << "pominiete (limit przekroczony przy V=" << limit << ")\n";
+                        record(res);
+                        continue;
+                    }
+                    Timer timer;
+                    timer.start();
+                    res.status = runCancellable([&] { return measureSweepCell(point, cases[j], reprs[r]); },
+                        config.timeoutMs, res.measurement, res.peakRssKb);
+                    timer.stop();
+                    res.elapsedMs = timer.resultNs() / 1e6;
+                    if (res.status == SweepStatus::TIMEOUT) limit = vertices;
+                    if (res.status == SweepStatus::OK)
+                        std::cout << res.measurement.stats.medianNs / 1e6 << " ms";
+                    else
+                        std::cout << sweepStatusName(res.status) << " po " << res.elapsedMs << " ms";
+                    if (res.peakRssKb >= 0) std::cout << ", RSS " << res.peakRssKb / 1024 << " MB";
+                    std::cout << "\n";
+                    record(res);
+                }
+            }
+        }
+    }
+    return results;
+}
+
+#endif // BENCHMARK_H
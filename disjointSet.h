@@ -0,0 +1,60 @@
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <vector>
+#include <numeric>
+#include <utility>
+
+// Struktura zbiorow rozlacznych: kompresja sciezki przez polowienie, laczenie wedlug rozmiaru.
+// Index - typ numerow elementow (jak Index w BasicCSRGraph).
+template <typename Index>
+class BasicDisjointSet {
+public:
+    explicit BasicDisjointSet(Index n) : parent(n), size(n, 1) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    // Ponowne uzycie dla n elementow bez nowej alokacji, gdy pojemnosc wystarcza
+    void reset(Index n) {
+        parent.resize(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        size.assign(n, 1);
+    }
+
+    Index find(Index x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Wersja bez kompresji sciezki - bezpieczna przy rownoczesnym odczycie z wielu watkow
+    Index root(Index x) const {
+        while (parent[x] != x) x = parent[x];
+        return x;
+    }
+
+    bool same(Index a, Index b) { return find(a) == find(b); }
+
+    // Zwraca false, gdy a i b juz sa w jednym zbiorze
+    bool unite(Index a, Index b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+
+    Index setSize(Index x) { return size[find(x)]; }
+
+private:
+    std::vector<Index> parent;
+    std::vector<Index> size;
+};
+
+using DisjointSet = BasicDisjointSet<int>;
+
+#endif // DISJOINT_SET_H
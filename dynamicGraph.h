@@ -0,0 +1,520 @@
+#ifndef DYNAMIC_GRAPH_H
+#define DYNAMIC_GRAPH_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <queue>
+#include <map>
+#include <tuple>
+#include "algorithms.h"
+#include "workspace.h"
+#include "generator.h"
+
+// Rodzaj zmiany w partii dla DynamicGraph::apply
+enum class EdgeUpdateKind {
+    INSERT,     // nowa krawedz; przy istniejacej zostaje mniejsza z wag (jak krawedz wielokrotna przy wczytaniu)
+    REMOVE,
+    WEIGHT      // nowa waga istniejacej krawedzi
+};
+
+struct EdgeUpdate {
+    EdgeUpdateKind kind;
+    int from, to;
+    int weight = 0;  // INSERT i WEIGHT
+};
+
+std::string edgeUpdateKindName(EdgeUpdateKind kind) {
+    switch (kind) {
+    case EdgeUpdateKind::INSERT: return "insert";
+    case EdgeUpdateKind::REMOVE: return "remove";
+    case EdgeUpdateKind::WEIGHT: return "weight";
+    }
+    return "?";
+}
+
+// Praca wykonana przez ostatnie apply - do porownania z pelnym przeliczeniem
+struct UpdateStats {
+    int mstReplacements = 0;    // krawedzie lasu wymienione na inne (cykl lub przekroj)
+    int affectedVertices = 0;   // wierzcholki uniewaznionych poddrzew najkrotszych sciezek
+    int settledVertices = 0;    // wierzcholki zdjete z kopca przy naprawie odleglosci
+};
+
+// Graf zmieniany partiami krawedzi, z utrzymywanym minimalnym lasem rozpinajacym (graf nieskierowany)
+// i drzewem najkrotszych sciezek z jednego zrodla (wagi nieujemne). Krawedzie wielokrotne sa przy budowie
+// laczone w jedna o najmniejszej wadze, wiec krawedz identyfikuje para koncow; petle sa pomijane.
+// Las naprawiany jest po kazdej zmianie: krawedz wstawiona lub tansza wypiera najciezsza krawedz cyklu,
+// usunieta lub drozsza krawedz lasu zastepowana jest najlzejsza krawedzia przekroju (skanowana mniejsza strona).
+// Odleglosci naprawiane sa raz na partie: poddrzewa pod lukami drzewa, ktore przestaly je wyznaczac, dostaja
+// najlepszego poprzednika spoza poddrzewa, a zmiany rozchodza sie Dijkstra tylko od zmienionych wierzcholkow.
+class DynamicGraph {
+public:
+    DynamicGraph(int vertices, bool directed, const std::vector<Edge>& edges);
+    explicit DynamicGraph(const Graph& g) : DynamicGraph(g.vertices, g.directed, g.edges) {}
+
+    int vertexCount() const { return n; }
+    bool isDirected() const { return directed; }
+    size_t edgeCount() const { return edgeTotal; }
+    bool hasEdge(int u, int v) const { return findArc(u, v) >= 0; }
+    int weight(int u, int v) const;
+    // Biezace krawedzie; dla grafu nieskierowanego kazda raz, z from < to
+    std::vector<Edge> edges() const;
+
+    // Wlaczenie utrzymywania wyniku - pierwszy liczony od zera (Kruskal, Dijkstra)
+    void maintainMST();
+    void maintainShortestPaths(int source);
+
+    // Cala partia jest sprawdzana przed zmiana czegokolwiek (zakres wierzcholkow, istnienie krawedzi
+    // dla REMOVE/WEIGHT, ujemne wagi przy utrzymywanych odleglosciach)
+    UpdateStats apply(const std::vector<EdgeUpdate>& batch);
+
+    std::vector<Edge> mst() const;
+    long long mstWeight() const { return treeWeight; }
+    const std::vector<int>& dist() const { return distances; }
+    const std::vector<int>& prev() const { return predecessors; }
+
+private:
+    using Adjacency = std::vector<std::vector<std::pair<int, int>>>;  // (sasiad, waga)
+
+    int n;
+    bool directed;
+    size_t edgeTotal = 0;
+    Adjacency out;
+    Adjacency in;      // luki wchodzace; tylko dla grafu skierowanego
+    bool mstActive = false;
+    Adjacency tree;    // las rozpinajacy
+    std::vector<int> up, upWeight;  // las ukorzeniony: rodzic (-1 w korzeniu) i waga krawedzi do rodzica
+    long long treeWeight = 0;
+    bool pathsActive = false;
+    int source = 0;
+    std::vector<int> distances, predecessors;
+    StampedArray<int> mark;  // przodkowie, strony przekroju lasu, poddrzewa najkrotszych sciezek
+
+    const std::vector<std::pair<int, int>>& incoming(int v) const { return directed ? in[v] : out[v]; }
+    int findArc(int u, int v) const;
+    static bool eraseArc(std::vector<std::pair<int, int>>& list, int v);
+    static void setArc(std::vector<std::pair<int, int>>& list, int v, int w);
+    void setEdge(int u, int v, int w);
+    void eraseEdge(int u, int v);
+    void validate(const std::vector<EdgeUpdate>& batch) const;
+
+    void reroot(int x);
+    void treeAdd(int u, int v, int w);
+    void treeRemove(int u, int v);
+    int treeWeightOf(int u, int v) const;
+    void repairMST(int u, int v, int oldWeight, bool existed, UpdateStats& stats);
+    void insertIntoForest(int u, int v, int w, UpdateStats& stats);
+    void reconnect(int u, int v, UpdateStats& stats);
+    void repairPaths(const std::vector<std::pair<int, int>>& touched, UpdateStats& stats);
+};
+
+DynamicGraph::DynamicGraph(int vertices, bool directed, const std::vector<Edge>& edges)
+    : n(vertices), directed(directed), out(vertices), in(directed ? vertices : 0), tree(directed ? 0 : vertices) {
+    // krawedzie wielokrotne: po sortowaniu wg (koniec, koniec, waga) zostaje pierwsza z pary
+    std::vector<Edge> unique;
+    unique.reserve(edges.size());
+    for (const Edge& e : edges) {
+        if (e.from < 0 || e.from >= n || e.to < 0 || e.to >= n) throw std::invalid_argument("Edge endpoint out of range");
+        if (e.from == e.to) continue;
+        if (directed || e.from < e.to) unique.push_back(e);
+        else unique.push_back({ e.to, e.from, e.weight });
+    }
+    std::sort(unique.begin(), unique.end(), [](const Edge& a, const Edge& b) {
+        return std::tie(a.from, a.to, a.weight) < std::tie(b.from, b.to, b.weight);
+    });
+    unique.erase(std::unique(unique.begin(), unique.end(), [](const Edge& a, const Edge& b) {
+        return a.from == b.from && a.to == b.to;
+    }), unique.end());
+    for (const Edge& e : unique) {
+        out[e.from].emplace_back(e.to, e.weight);
+        (directed ? in[e.to] : out[e.to]).emplace_back(e.from, e.weight);
+    }
+    edgeTotal = unique.size();
+}
+
+int DynamicGraph::findArc(int u, int v) const {
+    const std::vector<std::pair<int, int>>& list = out[u];
+    for (size_t i = 0; i < list.size(); ++i)
+        if (list[i].first == v) return static_cast<int>(i);
+    return -1;
+}
+
+int DynamicGraph::weight(int u, int v) const {
+    int arc = findArc(u, v);
+    if (arc < 0) throw std::invalid_argument("Edge does not exist");
+    return out[u][arc].second;
+}
+
+bool DynamicGraph::eraseArc(std::vector<std::pair<int, int>>& list, int v) {
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (list[i].first != v) continue;
+        list[i] = list.back();
+        list.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void DynamicGraph::setArc(std::vector<std::pair<int, int>>& list, int v, int w) {
+    for (std::pair<int, int>& arc : list) {
+        if (arc.first == v) {
+            arc.second = w;
+            return;
+        }
+    }
+    list.emplace_back(v, w);
+}
+
+void DynamicGraph::setEdge(int u, int v, int w) {
+    if (findArc(u, v) < 0) ++edgeTotal;
+    setArc(out[u], v, w);
+    setArc(directed ? in[v] : out[v], u, w);
+}
+
+void DynamicGraph::eraseEdge(int u, int v) {
+    if (eraseArc(out[u], v)) --edgeTotal;
+    eraseArc(directed ? in[v] : out[v], u);
+}
+
+std::vector<Edge> DynamicGraph::edges() const {
+    std::vector<Edge> result;
+    result.reserve(edgeTotal);
+    for (int u = 0; u < n; ++u)
+        for (const std::pair<int, int>& arc : out[u])
+            if (directed || u < arc.first) result.push_back({ u, arc.first, arc.second });
+    return result;
+}
+
+void DynamicGraph::maintainMST() {
+    if (directed) throw std::invalid_argument("Dynamic MST requires an undirected graph");
+    Graph g(n, false);
+    g.setEdges(edges());
+    for (std::vector<std::pair<int, int>>& list : tree) list.clear();
+    treeWeight = 0;
+    for (const Edge& e : GraphAlgorithms::kruskalMST(g)) {
+        tree[e.from].emplace_back(e.to, e.weight);
+        tree[e.to].emplace_back(e.from, e.weight);
+        treeWeight += e.weight;
+    }
+    // ukorzenienie kazdego drzewa BFS-em
+    up.assign(n, -1);
+    upWeight.assign(n, 0);
+    mark.reset(n, 0);
+    std::vector<int> queue;
+    for (int r = 0; r < n; ++r) {
+        if (mark.get(r)) continue;
+        mark.set(r, 1);
+        queue.assign(1, r);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int x = queue[head];
+            for (const std::pair<int, int>& arc : tree[x]) {
+                if (mark.get(arc.first)) continue;
+                mark.set(arc.first, 1);
+                up[arc.first] = x;
+                upWeight[arc.first] = arc.second;
+                queue.push_back(arc.first);
+            }
+        }
+    }
+    mstActive = true;
+}
+
+void DynamicGraph::maintainShortestPaths(int start) {
+    if (start < 0 || start >= n) throw std::invalid_argument("Source vertex out of range");
+    for (int u = 0; u < n; ++u)
+        for (const std::pair<int, int>& arc : out[u])
+            if (arc.second < 0) throw std::invalid_argument("Dynamic shortest paths require non-negative weights");
+    Graph g(n, directed);
+    g.setEdges(edges());
+    std::tie(distances, predecessors) = GraphAlgorithms::dijkstra(g, start);
+    source = start;
+    pathsActive = true;
+}
+
+std::vector<Edge> DynamicGraph::mst() const {
+    std::vector<Edge> result;
+    for (int u = 0; u < static_cast<int>(tree.size()); ++u)
+        for (const std::pair<int, int>& arc : tree[u])
+            if (u < arc.first) result.push_back({ u, arc.first, arc.second });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Istnienie krawedzi sledzone przez cala partie, bez zmiany grafu
+void DynamicGraph::validate(const std::vector<EdgeUpdate>& batch) const {
+    std::map<std::pair<int, int>, bool> present;
+    auto key = [&](int u, int v) { return directed || u < v ? std::make_pair(u, v) : std::make_pair(v, u); };
+    for (const EdgeUpdate& up : batch) {
+        if (up.from < 0 || up.from >= n || up.to < 0 || up.to >= n) throw std::invalid_argument("Edge update: vertex out of range");
+        if (up.kind != EdgeUpdateKind::REMOVE && pathsActive && up.weight < 0)
+            throw std::invalid_argument("Edge update: negative weight with maintained shortest paths");
+        if (up.from == up.to) continue;
+        auto it = present.try_emplace(key(up.from, up.to), hasEdge(up.from, up.to)).first;
+        if (up.kind != EdgeUpdateKind::INSERT && !it->second)
+            throw std::invalid_argument("Edge update: " + edgeUpdateKindName(up.kind) + " of missing edge "
+                + std::to_string(up.from) + " " + std::to_string(up.to));
+        it->second = up.kind != EdgeUpdateKind::REMOVE;
+    }
+}
+
+UpdateStats DynamicGraph::apply(const std::vector<EdgeUpdate>& batch) {
+    validate(batch);
+    UpdateStats stats;
+    std::vector<std::pair<int, int>> touched;
+    for (const EdgeUpdate& up : batch) {
+        if (up.from == up.to) continue;
+        int arc = findArc(up.from, up.to);
+        bool existed = arc >= 0;
+        int oldWeight = existed ? out[up.from][arc].second : 0;
+        if (up.kind == EdgeUpdateKind::REMOVE) eraseEdge(up.from, up.to);
+        else if (up.kind == EdgeUpdateKind::WEIGHT || !existed || up.weight < oldWeight) setEdge(up.from, up.to, up.weight);
+        if (mstActive) repairMST(up.from, up.to, oldWeight, existed, stats);
+        touched.emplace_back(up.from, up.to);
+    }
+    if (pathsActive) repairPaths(touched, stats);
+    return stats;
+}
+
+// x zostaje korzeniem swojego drzewa - odwrocenie krawedzi na sciezce do dotychczasowego korzenia
+void DynamicGraph::reroot(int x) {
+    int below = -1, belowWeight = 0;
+    while (x != -1) {
+        int next = up[x], nextWeight = upWeight[x];
+        up[x] = below;
+        upWeight[x] = belowWeight;
+        below = x;
+        belowWeight = nextWeight;
+        x = next;
+    }
+}
+
+// u i v musza lezec w roznych drzewach; drzewo u podwieszane jest pod v
+void DynamicGraph::treeAdd(int u, int v, int w) {
+    tree[u].emplace_back(v, w);
+    tree[v].emplace_back(u, w);
+    treeWeight += w;
+    reroot(u);
+    up[u] = v;
+    upWeight[u] = w;
+}
+
+void DynamicGraph::treeRemove(int u, int v) {
+    treeWeight -= treeWeightOf(u, v);
+    eraseArc(tree[u], v);
+    eraseArc(tree[v], u);
+    if (up[u] == v) up[u] = -1;
+    else up[v] = -1;
+}
+
+// Waga krawedzi lasu albo INT_MIN, gdy (u, v) nie nalezy do lasu
+int DynamicGraph::treeWeightOf(int u, int v) const {
+    if (up[u] == v) return upWeight[u];
+    if (up[v] == u) return upWeight[v];
+    return std::numeric_limits<int>::min();
+}
+
+// Graf jest juz zmieniony; oldWeight - waga sprzed zmiany, gdy existed
+void DynamicGraph::repairMST(int u, int v, int oldWeight, bool existed, UpdateStats& stats) {
+    int arc = findArc(u, v);
+    bool present = arc >= 0;
+    int newWeight = present ? out[u][arc].second : 0;
+    if (treeWeightOf(u, v) != std::numeric_limits<int>::min()) {
+        // krawedz lasu: tansza zostaje w lesie, drozsza lub usunieta moze ustapic krawedzi przekroju
+        if (present && newWeight <= oldWeight) {
+            treeRemove(u, v);
+            treeAdd(u, v, newWeight);
+            return;
+        }
+        treeRemove(u, v);
+        reconnect(u, v, stats);
+        return;
+    }
+    if (present && (!existed || newWeight < oldWeight)) insertIntoForest(u, v, newWeight, stats);
+}
+
+// Krawedz spoza lasu: domyka cykl, z ktorego wypada najciezsza krawedz, albo laczy dwa drzewa.
+// Cykl wyznacza najnizszy wspolny przodek u i v - koszt proporcjonalny do glebokosci, nie do rozmiaru drzewa.
+void DynamicGraph::insertIntoForest(int u, int v, int w, UpdateStats& stats) {
+    mark.reset(n, 0);
+    for (int x = u; x != -1; x = up[x]) mark.set(x, 1);
+    int ancestor = v;
+    while (ancestor != -1 && !mark.get(ancestor)) ancestor = up[ancestor];
+    if (ancestor == -1) {
+        treeAdd(u, v, w);
+        return;
+    }
+    int heaviestChild = -1, heaviest = std::numeric_limits<int>::min();
+    for (int end : { u, v }) {
+        for (int x = end; x != ancestor; x = up[x]) {
+            if (upWeight[x] <= heaviest) continue;
+            heaviest = upWeight[x];
+            heaviestChild = x;
+        }
+    }
+    if (heaviest <= w) return;
+    treeRemove(heaviestChild, up[heaviestChild]);
+    treeAdd(u, v, w);
+    ++stats.mstReplacements;
+}
+
+// Po usunieciu (u, v) z lasu: BFS naprzemiennie od obu koncow, az jedna strona sie wyczerpie;
+// jej krawedzie wychodzace poza nia sa kandydatami na krawedz laczaca
+void DynamicGraph::reconnect(int u, int v, UpdateStats& stats) {
+    mark.reset(n, 0);
+    std::vector<int> sides[2] = { { u }, { v } };
+    mark.set(u, 1);
+    mark.set(v, 2);
+    size_t heads[2] = { 0, 0 };
+    int smaller = -1;
+    while (smaller < 0) {
+        for (int s = 0; s < 2 && smaller < 0; ++s) {
+            if (heads[s] == sides[s].size()) {
+                smaller = s;
+                break;
+            }
+            int x = sides[s][heads[s]++];
+            for (const std::pair<int, int>& arc : tree[x]) {
+                if (mark.get(arc.first)) continue;
+                mark.set(arc.first, s + 1);
+                sides[s].push_back(arc.first);
+            }
+        }
+    }
+    int best = std::numeric_limits<int>::max(), bestFrom = -1, bestTo = -1;
+    for (int x : sides[smaller]) {
+        for (const std::pair<int, int>& arc : out[x]) {
+            if (mark.get(arc.first) == smaller + 1 || arc.second >= best) continue;
+            best = arc.second;
+            bestFrom = x;
+            bestTo = arc.first;
+        }
+    }
+    if (bestFrom < 0) return;
+    treeAdd(bestFrom, bestTo, best);
+    if (std::minmax(bestFrom, bestTo) != std::minmax(u, v)) ++stats.mstReplacements;
+}
+
+void DynamicGraph::repairPaths(const std::vector<std::pair<int, int>>& touched, UpdateStats& stats) {
+    const int INF = std::numeric_limits<int>::max();
+    using P = std::pair<int, int>;
+    std::priority_queue<P, std::vector<P>, std::greater<>> heap;
+
+    // luk a -> b; dla grafu nieskierowanego oba kierunki
+    auto forEachTouchedArc = [&](auto&& fn) {
+        for (const std::pair<int, int>& e : touched) {
+            fn(e.first, e.second);
+            if (!directed) fn(e.second, e.first);
+        }
+    };
+    // poddrzewa pod lukami drzewa, ktore zniknely lub zdrozaly
+    std::vector<int> roots;
+    forEachTouchedArc([&](int a, int b) {
+        if (predecessors[b] != a || distances[a] == INF) return;
+        int arc = findArc(a, b);
+        if (arc < 0 || distances[a] + out[a][arc].second > distances[b]) roots.push_back(b);
+    });
+    if (!roots.empty()) {
+        // dzieci w drzewie najkrotszych sciezek jako CSR z tablicy poprzednikow
+        std::vector<int> offsets(n + 1, 0), children(n);
+        for (int v = 0; v < n; ++v)
+            if (predecessors[v] >= 0) ++offsets[predecessors[v] + 1];
+        for (int v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+        std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+        for (int v = 0; v < n; ++v)
+            if (predecessors[v] >= 0) children[fill[predecessors[v]]++] = v;
+
+        mark.reset(n, 0);
+        std::vector<int> affected;
+        for (int r : roots) {
+            if (mark.get(r)) continue;
+            mark.set(r, 1);
+            affected.push_back(r);
+            for (size_t head = affected.size() - 1; head < affected.size(); ++head) {
+                int x = affected[head];
+                for (int c = offsets[x]; c < offsets[x + 1]; ++c) {
+                    if (mark.get(children[c])) continue;
+                    mark.set(children[c], 1);
+                    affected.push_back(children[c]);
+                }
+            }
+        }
+        for (int x : affected) {
+            distances[x] = INF;
+            predecessors[x] = -1;
+        }
+        for (int x : affected) {
+            for (const std::pair<int, int>& arc : incoming(x)) {
+                int y = arc.first;
+                if (mark.get(y) || distances[y] == INF || distances[y] + arc.second >= distances[x]) continue;
+                distances[x] = distances[y] + arc.second;
+                predecessors[x] = y;
+            }
+            if (distances[x] != INF) heap.emplace(distances[x], x);
+        }
+        stats.affectedVertices = static_cast<int>(affected.size());
+    }
+    // luki nowe lub tansze
+    forEachTouchedArc([&](int a, int b) {
+        if (distances[a] == INF) return;
+        int arc = findArc(a, b);
+        if (arc < 0 || distances[a] + out[a][arc].second >= distances[b]) return;
+        distances[b] = distances[a] + out[a][arc].second;
+        predecessors[b] = a;
+        heap.emplace(distances[b], b);
+    });
+
+    while (!heap.empty()) {
+        auto [d, x] = heap.top();
+        heap.pop();
+        if (d > distances[x]) continue;
+        ++stats.settledVertices;
+        for (const std::pair<int, int>& arc : out[x]) {
+            if (d + arc.second >= distances[arc.first]) continue;
+            distances[arc.first] = d + arc.second;
+            predecessors[arc.first] = x;
+            heap.emplace(distances[arc.first], arc.first);
+        }
+    }
+}
+
+// Losowa partia zmian istniejacego grafu: zmiany wag, usuniecia i wstawienia nowych krawedzi w proporcjach
+// 2:1:1; wagi z [minWeight, maxWeight]. Kolejne zmiany partii widza skutki poprzednich.
+std::vector<EdgeUpdate> randomEdgeUpdates(const DynamicGraph& g, int count, int minWeight, int maxWeight, RandomStream& rng) {
+    std::vector<EdgeUpdate> batch;
+    std::vector<Edge> current = g.edges();
+    auto vertex = [&]() { return static_cast<int>(rng.below(static_cast<uint64_t>(g.vertexCount()))); };
+    std::map<std::pair<int, int>, bool> changed;  // stan krawedzi zmienionych w tej partii
+    auto exists = [&](int u, int v) {
+        if (!g.isDirected() && u > v) std::swap(u, v);
+        auto it = changed.find({ u, v });
+        return it != changed.end() ? it->second : g.hasEdge(u, v);
+    };
+    auto record = [&](int u, int v, bool present) {
+        if (!g.isDirected() && u > v) std::swap(u, v);
+        changed[{ u, v }] = present;
+    };
+    // nieudane losowania (krawedz juz usunieta, para juz istnieje) ograniczone - graf moze byc pelny lub pusty
+    for (long long attempts = 0; static_cast<int>(batch.size()) < count && g.vertexCount() > 1 && attempts < 20LL * count + 100; ++attempts) {
+        int kind = static_cast<int>(rng.below(4));
+        if (kind < 3 && !current.empty()) {
+            const Edge& e = current[rng.below(current.size())];
+            if (!exists(e.from, e.to)) continue;
+            if (kind == 2) {
+                batch.push_back({ EdgeUpdateKind::REMOVE, e.from, e.to });
+                record(e.from, e.to, false);
+            }
+            else batch.push_back({ EdgeUpdateKind::WEIGHT, e.from, e.to, rng.between(minWeight, maxWeight) });
+            continue;
+        }
+        int u = vertex(), v = vertex();
+        if (u == v || exists(u, v)) continue;
+        batch.push_back({ EdgeUpdateKind::INSERT, u, v, rng.between(minWeight, maxWeight) });
+        record(u, v, true);
+        current.push_back({ u, v, 0 });
+    }
+    return batch;
+}
+
+#endif // DYNAMIC_GRAPH_H
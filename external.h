@@ -0,0 +1,372 @@
+#ifndef EXTERNAL_H
+#define EXTERNAL_H
+
+#include <string>
+#include <vector>
+#include <span>
+#include <queue>
+#include <fstream>
+#include <filesystem>
+#include <random>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include "algorithms.h"
+#include "disjointSet.h"
+#include "loader.h"
+
+// Tryb zewnetrzny (--external): lista krawedzi nie musi miescic sie w pamieci. Plik tekstowy czytany jest
+// sekwencyjnie blokami, pliki posrednie (rekordy Edge) trafiaja do katalogu roboczego usuwanego po zakonczeniu.
+// Poza buforami o stalym rozmiarze w pamieci trzymane sa tylko struktury O(V).
+
+struct ExternalOptions {
+    std::string scratchDir;                    // pusty - katalog tymczasowy systemu
+    size_t memoryBytes = size_t(256) << 20;    // przebieg sortowania, przy scalaniu dzielony miedzy pliki
+    size_t blockBytes = size_t(4) << 20;       // blok odczytu tekstu i zapisu plikow posrednich
+    size_t mergeFanIn = 64;                    // najwiecej przebiegow scalanych naraz
+};
+
+struct ExternalStats {
+    size_t runs = 0;                   // posortowane przebiegi zapisane na dysk (0 - sortowanie w pamieci)
+    int mergePasses = 0;               // poziomy scalania, ostatni bez zapisu
+    int scans = 0;                     // sekwencyjne odczyty calej listy krawedzi
+    unsigned long long bytesRead = 0;
+    unsigned long long bytesWritten = 0;
+};
+
+// Katalog na pliki posrednie o unikalnej nazwie; usuwany razem z zawartoscia w destruktorze
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& parent) {
+        namespace fs = std::filesystem;
+        fs::path base = parent.empty() ? fs::temp_directory_path() : fs::path(parent);
+        fs::create_directories(base);
+        std::random_device seed;
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            fs::path candidate = base / ("graph-external-" + std::to_string(seed()));
+            if (fs::create_directory(candidate)) {
+                dir = candidate;
+                return;
+            }
+        }
+        throw std::runtime_error("Cannot create scratch directory");
+    }
+
+    ~ScratchDirectory() {
+        std::error_code ignored;
+        std::filesystem::remove_all(dir, ignored);
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    // Nowa, jeszcze nieuzyta nazwa pliku w katalogu
+    std::string newFile() { return (dir / ("run-" + std::to_string(next++) + ".bin")).string(); }
+
+private:
+    std::filesystem::path dir;
+    size_t next = 0;
+};
+
+// Plik tekstowy "E V" + E linii "u v w" czytany blokami stalej wielkosci. Liczba przecieta granica bloku
+// przenoszona jest na poczatek bufora przed dolaczeniem kolejnego bloku.
+class TextEdgeReader {
+public:
+    TextEdgeReader(const std::string& filename, size_t blockBytes)
+        : in(filename, std::ios::binary), buffer(std::max<size_t>(blockBytes, 64)) {
+        if (!in) throw std::runtime_error("Cannot open input file");
+        int e, v;
+        if (!nextInt(e) || !nextInt(v) || e < 0 || v < 0) throw std::runtime_error("Malformed input file header");
+        remaining = e;
+        edgeCount = e;
+        vertexCount = v;
+    }
+
+    int vertices() const { return vertexCount; }
+    long long edges() const { return edgeCount; }
+    unsigned long long bytesRead() const { return bytes; }
+
+    // Dopisuje do out najwyzej limit kolejnych krawedzi; zwraca ich liczbe (0 - wszystkie E przeczytane)
+    size_t read(std::vector<Edge>& out, size_t limit) {
+        size_t added = 0;
+        for (; added < limit && remaining > 0; ++added, --remaining) {
+            Edge e;
+            if (!nextInt(e.from) || !nextInt(e.to) || !nextInt(e.weight))
+                throw std::runtime_error("Unexpected end of input file");
+            if (e.from < 0 || e.from >= vertexCount || e.to < 0 || e.to >= vertexCount)
+                throw std::runtime_error("Vertex id out of range in input file");
+            out.push_back(e);
+        }
+        return added;
+    }
+
+private:
+    bool nextInt(int& value) {
+        for (;;) {
+            const char* data = buffer.data();
+            const char* end = data + filled;
+            const char* p = data + pos;
+            while (p < end && isInputSpace(*p)) ++p;
+            pos = static_cast<size_t>(p - data);
+            // liczba dochodzaca do konca bufora moze ciagnac sie w nastepnym bloku
+            const char* q = p;
+            while (q < end && !isInputSpace(*q)) ++q;
+            if (q == end && !eof) {
+                refill();
+                continue;
+            }
+            q = p;
+            if (!scanInt(q, end, value, data, bytes - filled)) return false;
+            pos = static_cast<size_t>(q - data);
+            return true;
+        }
+    }
+
+    void refill() {
+        size_t keep = filled - pos;
+        if (keep == buffer.size()) throw std::runtime_error("Malformed input file: number longer than read block");
+        std::memmove(buffer.data(), buffer.data() + pos, keep);
+        pos = 0;
+        in.read(buffer.data() + keep, static_cast<std::streamsize>(buffer.size() - keep));
+        size_t got = static_cast<size_t>(in.gcount());
+        filled = keep + got;
+        bytes += got;
+        eof = got < buffer.size() - keep;
+    }
+
+    std::ifstream in;
+    std::vector<char> buffer;
+    size_t pos = 0, filled = 0;
+    bool eof = false;
+    long long remaining = 0, edgeCount = 0;
+    int vertexCount = 0;
+    unsigned long long bytes = 0;
+};
+
+// Zapis rekordow Edge do pliku posredniego przez bufor blockEdges krawedzi
+class EdgeRunWriter {
+public:
+    EdgeRunWriter(const std::string& filename, size_t blockEdges)
+        : out(filename, std::ios::binary | std::ios::trunc) {
+        if (!out) throw std::runtime_error("Cannot create scratch file");
+        buffer.reserve(std::max<size_t>(blockEdges, 1));
+    }
+
+    void push(const Edge& e) {
+        buffer.push_back(e);
+        if (buffer.size() == buffer.capacity()) flush();
+    }
+
+    void write(std::span<const Edge> edges) {
+        flush();
+        put(edges);
+    }
+
+    // Zwraca liczbe zapisanych bajtow
+    unsigned long long close() {
+        flush();
+        out.close();
+        if (!out) throw std::runtime_error("Cannot write scratch file");
+        return bytes;
+    }
+
+private:
+    void flush() {
+        put(buffer);
+        buffer.clear();
+    }
+
+    void put(std::span<const Edge> edges) {
+        out.write(reinterpret_cast<const char*>(edges.data()), static_cast<std::streamsize>(edges.size_bytes()));
+        if (!out) throw std::runtime_error("Cannot write scratch file");
+        bytes += edges.size_bytes();
+    }
+
+    std::ofstream out;
+    std::vector<Edge> buffer;
+    unsigned long long bytes = 0;
+};
+
+// Odczyt pliku posredniego kolejnymi blokami
+class EdgeRunReader {
+public:
+    EdgeRunReader(const std::string& filename, size_t blockEdges)
+        : in(filename, std::ios::binary), buffer(std::max<size_t>(blockEdges, 1)) {
+        if (!in) throw std::runtime_error("Cannot open scratch file");
+    }
+
+    // Nastepny blok; pusty na koncu pliku
+    std::span<const Edge> nextBlock() {
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(Edge)));
+        size_t got = static_cast<size_t>(in.gcount());
+        if (got % sizeof(Edge) != 0) throw std::runtime_error("Truncated scratch file");
+        bytes += got;
+        return { buffer.data(), got / sizeof(Edge) };
+    }
+
+    unsigned long long bytesRead() const { return bytes; }
+
+private:
+    std::ifstream in;
+    std::vector<Edge> buffer;
+    unsigned long long bytes = 0;
+};
+
+// Scala posortowane wg wagi pliki runs; emit(e) dostaje krawedzie rosnaco i zwraca false, gdy kolejne
+// nie sa potrzebne. Przy rownych wagach pierwszenstwo ma wczesniejszy plik.
+template <typename Emit>
+void mergeEdgeRuns(const std::vector<std::string>& runs, size_t blockEdges, ExternalStats& stats, Emit emit) {
+    struct Cursor {
+        EdgeRunReader reader;
+        std::span<const Edge> block;
+        size_t at = 0;
+    };
+    std::vector<Cursor> cursors;
+    cursors.reserve(runs.size());
+    for (const std::string& run : runs) cursors.push_back({ EdgeRunReader(run, blockEdges), {}, 0 });
+
+    auto later = [&cursors](size_t a, size_t b) {
+        int wa = cursors[a].block[cursors[a].at].weight, wb = cursors[b].block[cursors[b].at].weight;
+        return wa != wb ? wa > wb : a > b;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heads(later);
+    for (size_t i = 0; i < cursors.size(); ++i) {
+        cursors[i].block = cursors[i].reader.nextBlock();
+        if (!cursors[i].block.empty()) heads.push(i);
+    }
+    bool more = true;
+    while (more && !heads.empty()) {
+        size_t i = heads.top();
+        heads.pop();
+        Cursor& c = cursors[i];
+        more = emit(c.block[c.at]);
+        if (++c.at == c.block.size()) {
+            c.block = c.reader.nextBlock();
+            c.at = 0;
+        }
+        if (!c.block.empty()) heads.push(i);
+    }
+    for (const Cursor& c : cursors) stats.bytesRead += c.reader.bytesRead();
+}
+
+// Sortowanie zewnetrzne krawedzi wg wagi. Przebiegi wielkosci opt.memoryBytes sortowane sa w pamieci
+// i zapisywane; scalanie po opt.mergeFanIn plikow, az zostanie ich najwyzej tyle. Ostatnie scalanie
+// nie trafia na dysk - krawedzie przekazywane sa do consume(e) (false - koniec). Gdy caly plik miesci sie
+// w jednym przebiegu, nic nie jest zapisywane.
+template <typename Consume>
+void externalSortEdges(TextEdgeReader& input, const ExternalOptions& opt, ScratchDirectory& scratch,
+    ExternalStats& stats, Consume consume) {
+    const size_t runEdges = std::max<size_t>(opt.memoryBytes / sizeof(Edge), 1);
+    const size_t fanIn = std::max<size_t>(opt.mergeFanIn, 2);
+    const size_t blockEdges = std::max<size_t>(opt.blockBytes / sizeof(Edge), 1);
+
+    std::vector<std::string> runs;
+    {
+        PhaseScope phase("runs");
+        std::vector<Edge> run;
+        run.reserve(static_cast<size_t>(std::min<long long>(input.edges(), static_cast<long long>(runEdges))));
+        while (input.read(run, runEdges) > 0) {
+            std::sort(run.begin(), run.end());
+            if (runs.empty() && static_cast<long long>(run.size()) == input.edges()) {
+                stats.bytesRead += input.bytesRead();
+                stats.scans = 1;
+                for (const Edge& e : run)
+                    if (!consume(e)) break;
+                return;
+            }
+            runs.push_back(scratch.newFile());
+            EdgeRunWriter writer(runs.back(), blockEdges);
+            writer.write(run);
+            stats.bytesWritten += writer.close();
+            run.clear();
+        }
+        stats.bytesRead += input.bytesRead();
+        stats.runs = runs.size();
+        stats.scans = 1;
+    }
+
+    PhaseScope phase("merge");
+    // bufory scalanych plikow i bufor wyjscia dziela budzet pamieci
+    const size_t mergeBlock = std::max<size_t>(runEdges / (fanIn + 1), 1024);
+    while (runs.size() > fanIn) {
+        std::vector<std::string> merged;
+        for (size_t first = 0; first < runs.size(); first += fanIn) {
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + std::min(runs.size(), first + fanIn));
+            merged.push_back(scratch.newFile());
+            EdgeRunWriter writer(merged.back(), mergeBlock);
+            mergeEdgeRuns(group, mergeBlock, stats, [&writer](const Edge& e) {
+                writer.push(e);
+                return true;
+            });
+            stats.bytesWritten += writer.close();
+            for (const std::string& run : group) std::filesystem::remove(run);
+        }
+        runs = std::move(merged);
+        ++stats.mergePasses;
+        ++stats.scans;
+    }
+    mergeEdgeRuns(runs, mergeBlock, stats, consume);
+    ++stats.mergePasses;
+    ++stats.scans;
+}
+
+// Kruskal nad plikiem tekstowym bez wczytywania listy krawedzi: sortowanie zewnetrzne zasila DisjointSet,
+// scalanie konczy sie po V - 1 krawedziach drzewa. Graf nieskierowany jak w --file dla problemu 0.
+inline std::vector<Edge> externalKruskalMST(const std::string& filename, const ExternalOptions& opt, ExternalStats* stats = nullptr) {
+    TextEdgeReader input(filename, opt.blockBytes);
+    ScratchDirectory scratch(opt.scratchDir);
+    ExternalStats local;
+    DisjointSet sets(input.vertices());
+    const size_t target = input.vertices() > 0 ? static_cast<size_t>(input.vertices() - 1) : 0;
+    std::vector<Edge> mst;
+    mst.reserve(target);
+    if (target > 0) {
+        externalSortEdges(input, opt, scratch, local, [&](const Edge& e) {
+            if (sets.unite(e.from, e.to)) mst.push_back(e);
+            return mst.size() < target;
+        });
+    }
+    if (stats) *stats = local;
+    return mst;
+}
+
+// Liczba wierzcholkow z naglowka pliku tekstowego (do sprawdzenia start/end przed wlasciwym odczytem)
+inline int edgeFileVertices(const std::string& filename) {
+    return TextEdgeReader(filename, 4096).vertices();
+}
+
+// Bellman-Ford z lukami na dysku. Pierwszy przebieg czyta plik tekstowy i przepisuje krawedzie binarnie
+// do katalogu roboczego, kolejne sa sekwencyjnymi odczytami tej kopii. Przebiegi i wykrywanie ujemnego
+// cyklu jak w GraphAlgorithms::bellmanFordPasses (koniec po przebiegu bez zmian), luki from -> to.
+inline BellmanFordResult externalBellmanFord(const std::string& filename, int start, const ExternalOptions& opt, ExternalStats* stats = nullptr) {
+    TextEdgeReader input(filename, opt.blockBytes);
+    if (start < 0 || start >= input.vertices()) throw std::invalid_argument("Start vertex out of range");
+    ScratchDirectory scratch(opt.scratchDir);
+    const std::string copy = scratch.newFile();
+    const size_t blockEdges = std::max<size_t>(opt.blockBytes / sizeof(Edge), 1);
+    ExternalStats local;
+
+    std::vector<Edge> block;
+    block.reserve(blockEdges);
+    BellmanFordResult r = GraphAlgorithms::bellmanFordPasses(input.vertices(), start, [&](const std::vector<int>&, auto&& relax) {
+        if (local.scans++ == 0) {
+            EdgeRunWriter writer(copy, blockEdges);
+            while (input.read(block, blockEdges) > 0) {
+                for (const Edge& e : block) relax(e.from, e.to, e.weight);
+                writer.write(block);
+                block.clear();
+            }
+            local.bytesWritten += writer.close();
+            local.bytesRead += input.bytesRead();
+            return;
+        }
+        EdgeRunReader reader(copy, blockEdges);
+        for (std::span<const Edge> b = reader.nextBlock(); !b.empty(); b = reader.nextBlock())
+            for (const Edge& e : b) relax(e.from, e.to, e.weight);
+        local.bytesRead += reader.bytesRead();
+    });
+    if (stats) *stats = local;
+    return r;
+}
+
+#endif // EXTERNAL_H
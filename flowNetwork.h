@@ -0,0 +1,53 @@
+#ifndef FLOW_NETWORK_H
+#define FLOW_NETWORK_H
+
+#include <vector>
+#include <stdexcept>
+
+// Siec residualna w ukladzie CSR: kazdy luk ma pare (rev) w przeciwnym kierunku.
+// Luki wierzcholka u zajmuja indeksy [offsets[u], offsets[u + 1]); cap to pojemnosc residualna.
+struct FlowNetwork {
+    int vertices = 0;
+    std::vector<int> offsets;
+    std::vector<int> head;
+    std::vector<int> rev;
+    std::vector<long long> cap;
+    std::vector<int> edgeArc;  // indeks luku w przod dla i-tej krawedzi wejsciowej (-1 dla petli)
+
+    // Krawedz skierowana daje luk o pojemnosci w i luk powrotny 0; nieskierowana - dwa luki o pojemnosci w
+    template <typename EdgeRange>
+    FlowNetwork(int n, bool directed, const EdgeRange& edges) : vertices(n), offsets(n + 1, 0) {
+        int edgeCount = 0;
+        for (const auto& e : edges) {
+            if (e.weight < 0) throw std::invalid_argument("Negative capacity in flow network");
+            ++edgeCount;
+            if (e.from == e.to) continue;
+            ++offsets[e.from + 1];
+            ++offsets[e.to + 1];
+        }
+        for (int u = 0; u < n; ++u) offsets[u + 1] += offsets[u];
+        head.resize(offsets[n]);
+        rev.resize(offsets[n]);
+        cap.resize(offsets[n]);
+        edgeArc.assign(edgeCount, -1);
+
+        std::vector<int> pos(offsets.begin(), offsets.end() - 1);
+        int idx = 0;
+        for (const auto& e : edges) {
+            int i = idx++;
+            if (e.from == e.to) continue;
+            int a = pos[e.from]++, b = pos[e.to]++;
+            head[a] = e.to;
+            head[b] = e.from;
+            rev[a] = b;
+            rev[b] = a;
+            cap[a] = e.weight;
+            cap[b] = directed ? 0 : e.weight;
+            edgeArc[i] = a;
+        }
+    }
+
+    int tail(int arc) const { return head[rev[arc]]; }
+};
+
+#endif // FLOW_NETWORK_H
@@ -0,0 +1,317 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <bit>
+#include <algorithm>
+#include <unordered_set>
+#include <stdexcept>
+#include "algorithms.h"
+#include "parallel.h"
+
+// Model losowego grafu
+enum class GraphModel {
+    GNM,    // dokladnie m = gestosc * maks. liczba krawedzi roznych par (jak dotychczas)
+    GNP,    // kazda para niezaleznie z prawdopodobienstwem p = gestosc
+    RMAT,   // rekurencyjna macierz (a, b, c, d) = (0.57, 0.19, 0.19, 0.05) - rozklad stopni o grubym ogonie
+    GRID    // siatka 2D z sasiadami w pionie i poziomie; gestosc jest ignorowana
+};
+
+struct GeneratorOptions {
+    GraphModel model = GraphModel::GNM;
+    uint64_t seed = 1;
+    unsigned threads = defaultThreadCount();
+    int minWeight = 1;
+    int maxWeight = 100;
+};
+
+// Przestrzen par dzielona jest na stala liczbe blokow, kazdy z wlasnym strumieniem losowym
+// wyprowadzonym z (seed, numer bloku). Wynik zalezy wiec tylko od ziarna, nie od liczby watkow.
+constexpr size_t GENERATOR_BLOCKS = 256;
+
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** - wlasna implementacja i wlasne rozklady, zeby ziarno dawalo ten sam graf
+// niezaleznie od biblioteki standardowej
+class RandomStream {
+public:
+    RandomStream(uint64_t seed, uint64_t stream) {
+        uint64_t sm = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        for (uint64_t& word : s) word = splitMix64(sm);
+    }
+
+    uint64_t next() {
+        uint64_t result = std::rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = std::rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, 1)
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // [0, bound) bez obciazenia (odrzucanie reszty)
+    uint64_t below(uint64_t bound) {
+        uint64_t threshold = (0 - bound) % bound;
+        uint64_t x;
+        do x = next(); while (x < threshold);
+        return x % bound;
+    }
+
+    int between(int lo, int hi) { return lo + static_cast<int>(below(static_cast<uint64_t>(hi - lo) + 1)); }
+
+private:
+    uint64_t s[4];
+};
+
+// Pary (i, j) numerowane wierszami: dla grafu nieskierowanego j > i, dla skierowanego j != i
+struct PairSpace {
+    int n;
+    bool directed;
+
+    uint64_t rowPairs(int i) const { return directed ? static_cast<uint64_t>(n - 1) : static_cast<uint64_t>(n - 1 - i); }
+    uint64_t total() const {
+        uint64_t v = static_cast<uint64_t>(n);
+        return n < 2 ? 0 : (directed ? v * (v - 1) : v * (v - 1) / 2);
+    }
+    int column(int i, uint64_t c) const {
+        int j = static_cast<int>(c);
+        return directed ? j + (j >= i) : i + 1 + j;
+    }
+
+    // Granice wierszy blokow o mozliwie rownej liczbie par; pairBase[b] - numer pierwszej pary bloku
+    void split(size_t blocks, std::vector<int>& rowBounds, std::vector<uint64_t>& pairBase) const {
+        blocks = std::max<size_t>(1, std::min<size_t>(blocks, static_cast<size_t>(std::max(n, 1))));
+        rowBounds.assign(blocks + 1, n);
+        pairBase.assign(blocks + 1, total());
+        rowBounds[0] = 0;
+        pairBase[0] = 0;
+        uint64_t sum = 0;
+        size_t b = 1;
+        for (int i = 0; i < n && b < blocks; ++i) {
+            sum += rowPairs(i);
+            while (b < blocks && sum >= total() / blocks * b) {
+                rowBounds[b] = i + 1;
+                pairBase[b] = sum;
+                ++b;
+            }
+        }
+    }
+};
+
+// Zamienia rosnaco posortowane numery par bloku (liczone od poczatku bloku) na krawedzie
+inline void emitPairs(const PairSpace& space, int firstRow, const std::vector<uint64_t>& picks,
+    RandomStream& rng, const GeneratorOptions& opt, std::vector<Edge>& out) {
+    int row = firstRow;
+    uint64_t rowStart = 0;
+    out.reserve(out.size() + picks.size());
+    for (uint64_t k : picks) {
+        while (k >= rowStart + space.rowPairs(row)) rowStart += space.rowPairs(row++);
+        out.push_back({ row, space.column(row, k - rowStart), rng.between(opt.minWeight, opt.maxWeight) });
+    }
+}
+
+// G(n, p): odstep do nastepnej wybranej pary losowany z rozkladu geometrycznego - O(E) zamiast O(V^2)
+inline void generateGnpBlock(const PairSpace& space, int firstRow, uint64_t pairs, double p,
+    RandomStream& rng, const GeneratorOptions& opt, std::vector<Edge>& out) {
+    if (p <= 0.0 || pairs == 0) return;
+    std::vector<uint64_t> picks;
+    picks.reserve(static_cast<size_t>(static_cast<double>(pairs) * p * 1.05) + 16);
+    if (p >= 1.0) {
+        for (uint64_t k = 0; k < pairs; ++k) picks.push_back(k);
+    }
+    else {
+        double logQ = std::log1p(-p);
+        double k = -1.0;
+        while (true) {
+            k += 1.0 + std::floor(std::log1p(-rng.uniform()) / logQ);
+            if (k >= static_cast<double>(pairs)) break;
+            picks.push_back(static_cast<uint64_t>(k));
+        }
+    }
+    emitPairs(space, firstRow, picks, rng, opt, out);
+}
+
+// G(n, m) w bloku: m roznych par z 'pairs'. Przy malej gestosci algorytm Floyda (O(m) z haszowaniem),
+// przy duzej wybor sekwencyjny (algorytm S Knutha), ktory przy m > pairs / 2 tez jest O(m).
+inline void generateGnmBlock(const PairSpace& space, int firstRow, uint64_t pairs, uint64_t m,
+    RandomStream& rng, const GeneratorOptions& opt, std::vector<Edge>& out) {
+    std::vector<uint64_t> picks;
+    picks.reserve(m);
+    if (m * 2 <= pairs) {
+        std::unordered_set<uint64_t> chosen;
+        chosen.reserve(m * 2);
+        for (uint64_t j = pairs - m; j < pairs; ++j) {
+            uint64_t t = rng.below(j + 1);
+            uint64_t pick = chosen.insert(t).second ? t : j;
+            if (pick == j) chosen.insert(j);
+            picks.push_back(pick);
+        }
+        std::sort(picks.begin(), picks.end());
+    }
+    else {
+        uint64_t needed = m;
+        for (uint64_t k = 0; k < pairs && needed > 0; ++k)
+            if (rng.below(pairs - k) < needed) {
+                picks.push_back(k);
+                --needed;
+            }
+    }
+    emitPairs(space, firstRow, picks, rng, opt, out);
+}
+
+// R-MAT: kazda krawedz schodzi po bitach numerow wierzcholkow, wybierajac cwiartke macierzy;
+// petle i wierzcholki >= n sa losowane ponownie, numery na koniec permutowane (inaczej huby to 0, 1, 2...)
+inline void generateRmatBlock(int n, uint64_t m, RandomStream& rng, const GeneratorOptions& opt, std::vector<Edge>& out) {
+    const double a = 0.57, b = 0.19, c = 0.19;
+    int scale = std::bit_width(static_cast<unsigned>(n - 1));
+    out.reserve(out.size() + m);
+    for (uint64_t e = 0; e < m; ++e) {
+        int u, v;
+        do {
+            u = v = 0;
+            for (int bit = scale - 1; bit >= 0; --bit) {
+                double r = rng.uniform();
+                if (r < a) continue;
+                if (r < a + b) v |= 1 << bit;
+                else if (r < a + b + c) u |= 1 << bit;
+                else {
+                    u |= 1 << bit;
+                    v |= 1 << bit;
+                }
+            }
+        } while (u >= n || v >= n || u == v);
+        out.push_back({ u, v, rng.between(opt.minWeight, opt.maxWeight) });
+    }
+}
+
+// Siatka rows x cols (rows = floor(sqrt(n))); w grafie skierowanym kazda krawedz w obu kierunkach
+inline void generateGridBlock(int n, bool directed, int cols, int rowBegin, int rowEnd,
+    RandomStream& rng, const GeneratorOptions& opt, std::vector<Edge>& out) {
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int u = r * cols + c;
+            if (u >= n) return;
+            int neighbors[2] = { c + 1 < cols ? u + 1 : n, u + cols };
+            for (int v : neighbors) {
+                if (v >= n) continue;
+                int w = rng.between(opt.minWeight, opt.maxWeight);
+                out.push_back({ u, v, w });
+                if (directed) out.push_back({ v, u, w });
+            }
+        }
+    }
+}
+
+// Lista krawedzi losowego grafu: bloki generowane rownolegle, laczone w kolejnosci blokow
+std::vector<Edge> generateEdges(int vertices, double density, bool directed, const GeneratorOptions& opt) {
+    if (vertices < 0) throw std::invalid_argument("Vertex count must be non-negative");
+    if (opt.minWeight > opt.maxWeight) throw std::invalid_argument("Empty weight range");
+    density = std::clamp(density, 0.0, 1.0);
+    PairSpace space{ vertices, directed };
+    uint64_t m = static_cast<uint64_t>(static_cast<long double>(space.total()) * density);
+    std::vector<std::vector<Edge>> blocks;
+
+    auto runBlocks = [&](size_t count, auto&& body) {
+        blocks.assign(count, {});
+        parallelForBlocks(count, opt.threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t b = begin; b < end; ++b) {
+                RandomStream rng(opt.seed, b);
+                body(b, rng, blocks[b]);
+            }
+        });
+    };
+
+    if (opt.model == GraphModel::GNM || opt.model == GraphModel::GNP) {
+        std::vector<int> rowBounds;
+        std::vector<uint64_t> pairBase;
+        space.split(GENERATOR_BLOCKS, rowBounds, pairBase);
+        size_t count = rowBounds.size() - 1;
+        std::vector<uint64_t> share(count, 0);
+        if (opt.model == GraphModel::GNM && space.total() > 0) {
+            // m rozdzielone proporcjonalnie do liczby par w bloku; reszty przydzielane losowaniem systematycznym,
+            // wiec kazda para ma dokladnie prawdopodobienstwo m / N, a w bloku losowanie jest jednostajne
+            RandomStream rng(opt.seed, GENERATOR_BLOCKS + 1);
+            long double offset = rng.uniform(), cumulative = 0;
+            uint64_t assigned = 0;
+            for (size_t b = 0; b < count; ++b) {
+                uint64_t pairs = pairBase[b + 1] - pairBase[b];
+                long double exact = static_cast<long double>(m) * pairs / space.total();
+                uint64_t base = static_cast<uint64_t>(exact);
+                long double next = cumulative + (exact - base);
+                uint64_t extra = static_cast<uint64_t>(std::floor(next - offset) - std::floor(cumulative - offset));
+                share[b] = std::min(pairs, base + extra);
+                cumulative = next;
+                assigned += share[b];
+            }
+            // korekta bledu zaokraglen (przy dokladnej arytmetyce suma jest rowna m)
+            for (size_t b = 0; assigned > m; b = (b + 1) % count)
+                if (share[b] > 0) {
+                    --share[b];
+                    --assigned;
+                }
+            for (size_t b = 0; assigned < m; b = (b + 1) % count)
+                if (share[b] < pairBase[b + 1] - pairBase[b]) {
+                    ++share[b];
+                    ++assigned;
+                }
+        }
+        runBlocks(count, [&](size_t b, RandomStream& rng, std::vector<Edge>& out) {
+            uint64_t pairs = pairBase[b + 1] - pairBase[b];
+            if (opt.model == GraphModel::GNP) generateGnpBlock(space, rowBounds[b], pairs, density, rng, opt, out);
+            else generateGnmBlock(space, rowBounds[b], pairs, share[b], rng, opt, out);
+        });
+    }
+    else if (opt.model == GraphModel::RMAT) {
+        if (vertices < 2) return {};
+        runBlocks(GENERATOR_BLOCKS, [&](size_t b, RandomStream& rng, std::vector<Edge>& out) {
+            generateRmatBlock(vertices, m / GENERATOR_BLOCKS + (b < m % GENERATOR_BLOCKS), rng, opt, out);
+        });
+    }
+    else {
+        int rows = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(vertices))));
+        int cols = vertices == 0 ? 0 : (vertices + rows - 1) / rows;
+        size_t count = std::min<size_t>(GENERATOR_BLOCKS, static_cast<size_t>(rows));
+        runBlocks(count, [&](size_t b, RandomStream& rng, std::vector<Edge>& out) {
+            generateGridBlock(vertices, directed, cols, static_cast<int>(rows * b / count), static_cast<int>(rows * (b + 1) / count), rng, opt, out);
+        });
+    }
+
+    size_t total = 0;
+    for (const std::vector<Edge>& block : blocks) total += block.size();
+    std::vector<Edge> edges;
+    edges.reserve(total);
+    for (std::vector<Edge>& block : blocks) {
+        edges.insert(edges.end(), block.begin(), block.end());
+        std::vector<Edge>().swap(block);
+    }
+
+    if (opt.model == GraphModel::RMAT) {
+        // losowa permutacja numerow wierzcholkow ze strumienia spoza zakresu blokow
+        std::vector<int> label(vertices);
+        for (int v = 0; v < vertices; ++v) label[v] = v;
+        RandomStream rng(opt.seed, GENERATOR_BLOCKS);
+        for (int v = vertices - 1; v > 0; --v) std::swap(label[v], label[rng.below(static_cast<uint64_t>(v) + 1)]);
+        parallelForBlocks(edges.size(), opt.threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                edges[i].from = label[edges[i].from];
+                edges[i].to = label[edges[i].to];
+            }
+        });
+    }
+    return edges;
+}
+
+#endif // GENERATOR_H
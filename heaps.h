@@ -0,0 +1,243 @@
+#ifndef HEAPS_H
+#define HEAPS_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+// Kolejki priorytetowe indeksowane numerem wierzcholka (0..n-1) z operacja decreaseKey.
+// Wspolny interfejs: empty(), contains(v), key(v), push(v, k), decreaseKey(v, k), pop().
+
+// Kopiec d-arny (Arity = 2 - binarny, Arity = 4 - czworkowy)
+template <int Arity>
+class IndexedDaryHeap {
+public:
+    explicit IndexedDaryHeap(int n) : pos(n, -1), keys(n, std::numeric_limits<int>::max()) {
+        heap.reserve(n);
+    }
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int v) const { return pos[v] != -1; }
+    int key(int v) const { return keys[v]; }
+
+    void push(int v, int k) {
+        keys[v] = k;
+        pos[v] = static_cast<int>(heap.size());
+        heap.push_back(v);
+        siftUp(pos[v]);
+    }
+
+    void decreaseKey(int v, int k) {
+        keys[v] = k;
+        siftUp(pos[v]);
+    }
+
+    // Zdejmuje wierzcholek o najmniejszym kluczu
+    int pop() {
+        int top = heap[0];
+        pos[top] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    std::vector<int> heap;
+    std::vector<int> pos;
+    std::vector<int> keys;
+
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / Arity;
+            if (keys[heap[parent]] <= keys[v]) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void siftDown(int i) {
+        int v = heap[i];
+        int size = static_cast<int>(heap.size());
+        while (true) {
+            int first = i * Arity + 1;
+            if (first >= size) break;
+            int best = first;
+            int end = std::min(first + Arity, size);
+            for (int c = first + 1; c < end; ++c)
+                if (keys[heap[c]] < keys[heap[best]]) best = c;
+            if (keys[heap[best]] >= keys[v]) break;
+            heap[i] = heap[best];
+            pos[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+};
+
+using IndexedBinaryHeap = IndexedDaryHeap<2>;
+using IndexedQuadHeap = IndexedDaryHeap<4>;
+
+// Kopiec parujacy: wezly w tablicach (dziecko, brat, poprzednik), laczenie dwuprzebiegowe przy pop()
+class IndexedPairingHeap {
+public:
+    explicit IndexedPairingHeap(int n)
+        : child(n, -1), sibling(n, -1), prev(n, -1), keys(n, std::numeric_limits<int>::max()), inHeap(n, false) {
+    }
+
+    bool empty() const { return root == -1; }
+    bool contains(int v) const { return inHeap[v]; }
+    int key(int v) const { return keys[v]; }
+
+    void push(int v, int k) {
+        keys[v] = k;
+        child[v] = sibling[v] = prev[v] = -1;
+        inHeap[v] = true;
+        root = (root == -1) ? v : meld(root, v);
+    }
+
+    void decreaseKey(int v, int k) {
+        keys[v] = k;
+        if (v == root) return;
+        // odciecie poddrzewa v i polaczenie z korzeniem
+        if (child[prev[v]] == v) child[prev[v]] = sibling[v];
+        else sibling[prev[v]] = sibling[v];
+        if (sibling[v] != -1) prev[sibling[v]] = prev[v];
+        sibling[v] = prev[v] = -1;
+        root = meld(root, v);
+    }
+
+    int pop() {
+        int top = root;
+        inHeap[top] = false;
+        root = mergePairs(child[top]);
+        if (root != -1) prev[root] = -1;
+        child[top] = -1;
+        return top;
+    }
+
+private:
+    std::vector<int> child, sibling, prev, keys;
+    std::vector<bool> inHeap;
+    std::vector<int> pairs;
+    int root = -1;
+
+    int meld(int a, int b) {
+        if (keys[b] < keys[a]) std::swap(a, b);
+        // b zostaje pierwszym dzieckiem a
+        sibling[b] = child[a];
+        if (child[a] != -1) prev[child[a]] = b;
+        prev[b] = a;
+        child[a] = b;
+        sibling[a] = -1;
+        return a;
+    }
+
+    int mergePairs(int first) {
+        if (first == -1) return -1;
+        pairs.clear();
+        // pierwszy przebieg: laczenie kolejnych par od lewej
+        while (first != -1) {
+            int a = first;
+            int b = sibling[a];
+            if (b == -1) {
+                sibling[a] = prev[a] = -1;
+                pairs.push_back(a);
+                break;
+            }
+            first = sibling[b];
+            sibling[a] = prev[a] = sibling[b] = prev[b] = -1;
+            pairs.push_back(meld(a, b));
+        }
+        // drugi przebieg: laczenie od prawej do lewej
+        int result = pairs.back();
+        for (int i = static_cast<int>(pairs.size()) - 2; i >= 0; --i)
+            result = meld(pairs[i], result);
+        return result;
+    }
+};
+
+// Kolejki monotoniczne dla Dijkstry z leniwym usuwaniem: klucze zdejmowane sa niemalejaco,
+// a kazdy wstawiany klucz jest >= ostatnio zdjetemu. Interfejs: empty(), push(k, v), pop() -> {k, v}.
+
+// Kolejka kubelkowa Diala: C + 1 kubelkow cyklicznie, C - maksymalna waga krawedzi.
+// Powyzej DIAL_MAX_WEIGHT tablica kubelkow bylaby zbyt duza - Dijkstra uzywa wtedy kopca radix.
+constexpr int DIAL_MAX_WEIGHT = 1 << 22;
+
+class DialQueue {
+public:
+    explicit DialQueue(int maxWeight) : buckets(static_cast<size_t>(maxWeight) + 1) {}
+
+    bool empty() const { return count == 0; }
+
+    void push(int k, int v) {
+        buckets[static_cast<size_t>(k) % buckets.size()].push_back(v);
+        ++count;
+    }
+
+    std::pair<int, int> pop() {
+        while (buckets[static_cast<size_t>(current) % buckets.size()].empty()) ++current;
+        std::vector<int>& bucket = buckets[static_cast<size_t>(current) % buckets.size()];
+        int v = bucket.back();
+        bucket.pop_back();
+        --count;
+        return { current, v };
+    }
+
+private:
+    std::vector<std::vector<int>> buckets;
+    size_t count = 0;
+    int current = 0;
+};
+
+// Kopiec radix: kubelek i zawiera klucze, ktorych najstarszy bit rozny od ostatnio zdjetego klucza to bit i-1
+class RadixHeap {
+public:
+    bool empty() const { return count == 0; }
+
+    void push(int k, int v) {
+        buckets[bucketIndex(static_cast<uint32_t>(k))].emplace_back(static_cast<uint32_t>(k), v);
+        ++count;
+    }
+
+    std::pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            // nowe minimum wyznacza punkt odniesienia - elementy kubelka i rozchodza sie do nizszych
+            last = buckets[i][0].first;
+            for (const std::pair<uint32_t, int>& item : buckets[i])
+                last = std::min(last, item.first);
+            for (const std::pair<uint32_t, int>& item : buckets[i])
+                buckets[bucketIndex(item.first)].push_back(item);
+            buckets[i].clear();
+        }
+        std::pair<uint32_t, int> top = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return { static_cast<int>(top.first), top.second };
+    }
+
+private:
+    std::vector<std::pair<uint32_t, int>> buckets[33];
+    uint32_t last = 0;
+    size_t count = 0;
+
+    int bucketIndex(uint32_t k) const {
+        return k == last ? 0 : 32 - std::countl_zero(k ^ last);
+    }
+};
+
+#endif // HEAPS_H
@@ -0,0 +1,190 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <fstream>
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <cstdint>
+#include <exception>
+#include "algorithms.h"
+#include "parallel.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define GRAPH_HAS_MMAP 1
+#endif
+
+// Plik zmapowany tylko do odczytu; bez mmap (np. Windows) zawartosc wczytywana jest do bufora
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef GRAPH_HAS_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open input file");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat input file");
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map input file");
+            }
+            ::madvise(p, length, MADV_SEQUENTIAL);
+            mapping = static_cast<const char*>(p);
+        }
+        ::close(fd);
+#else
+        std::ifstream in(filename, std::ios::binary);
+        if (!in) throw std::runtime_error("Cannot open input file");
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        length = buffer.size();
+        mapping = buffer.data();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef GRAPH_HAS_MMAP
+        if (mapping && length > 0) ::munmap(const_cast<char*>(mapping), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return mapping; }
+    size_t size() const { return length; }
+
+private:
+    const char* mapping = nullptr;
+    size_t length = 0;
+#ifndef GRAPH_HAS_MMAP
+    std::vector<char> buffer;
+#endif
+};
+
+inline bool isInputSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Czyta kolejna liczbe calkowita z [p, end); false, gdy do konca zostaly tylko biale znaki.
+// Dozwolone sa wylacznie biale znaki i liczby [-]cyfry w zakresie int - inaczej wyjatek z pozycja bledu
+// liczona od origin (originOffset - pozycja origin w pliku, gdy [p, end) jest fragmentem bufora).
+// Petla po cyfrach korzysta z porownania bez znaku zamiast dwoch warunkow na znak.
+inline bool scanInt(const char*& p, const char* end, int& value, const char* origin, uint64_t originOffset = 0) {
+    while (p < end && isInputSpace(*p)) ++p;
+    if (p == end) return false;
+    const char* start = p;
+    auto fail = [&](const char* what) {
+        throw std::runtime_error(std::string(what) + " at byte " + std::to_string(originOffset + static_cast<uint64_t>(start - origin))
+            + " of input file");
+    };
+    bool negative = *p == '-';
+    p += negative;
+    const long long limit = negative ? -static_cast<long long>(std::numeric_limits<int>::min()) : std::numeric_limits<int>::max();
+    long long result = 0;
+    unsigned digit;
+    const char* digits = p;
+    while (p < end && (digit = static_cast<unsigned>(*p - '0')) <= 9u) {
+        result = result * 10 + digit;
+        if (result > limit) fail("Number out of int range");
+        ++p;
+    }
+    if (p == digits || (p < end && !isInputSpace(*p))) fail("Malformed number");
+    value = static_cast<int>(negative ? -result : result);
+    return true;
+}
+
+// Parsuje trojki "u v w" z [begin, end); zwraca false, gdy liczba liczb nie jest podzielna przez 3
+inline bool scanEdges(const char* begin, const char* end, std::vector<Edge>& out, const char* origin) {
+    const char* p = begin;
+    int values[3];
+    int filled = 0;
+    while (scanInt(p, end, values[filled], origin)) {
+        if (++filled == 3) {
+            out.push_back({ values[0], values[1], values[2] });
+            filled = 0;
+        }
+    }
+    return filled == 0;
+}
+
+// Szybkie wczytanie grafu w formacie tekstowym "E V" + E linii "u v w".
+// Tresc po naglowku dzielona jest na bloki zakonczone znakiem nowej linii i parsowana rownolegle;
+// przy nietypowym ukladzie (krawedz rozbita na kilka linii) nastepuje powrot do parsowania w jednym watku.
+Graph loadGraphFast(const std::string& filename, bool directed, GraphRepresentation repr, unsigned threads = defaultThreadCount()) {
+    MappedFile file(filename);
+    const char* p = file.data();
+    const char* end = p + file.size();
+    int edgeCount, vertices;
+    if (!scanInt(p, end, edgeCount, file.data()) || !scanInt(p, end, vertices, file.data()) || edgeCount < 0 || vertices < 0)
+        throw std::runtime_error("Malformed input file header");
+
+    size_t bodySize = static_cast<size_t>(end - p);
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(bodySize / (1 << 20) + 1)));
+    std::vector<const char*> bounds(threads + 1, end);
+    bounds[0] = p;
+    for (unsigned t = 1; t < threads; ++t) {
+        const char* cut = std::max(bounds[t - 1], p + bodySize * t / threads);
+        while (cut < end && *cut != '\n') ++cut;
+        bounds[t] = cut;
+    }
+
+    // rezerwacja z naglowka ograniczona tym, co blok moze zawierac (krawedz "u v w" ma co najmniej 6 bajtow)
+    const size_t MIN_EDGE_BYTES = 6;
+    std::vector<std::vector<Edge>> chunks(threads);
+    std::vector<char> aligned(threads, 1);
+    std::vector<std::exception_ptr> errors(threads);  // blad z najwczesniejszego bloku zglaszany po zakonczeniu watkow
+    parallelForBlocks(threads, threads, [&](size_t begin, size_t stop, unsigned) {
+        for (size_t c = begin; c < stop; ++c) {
+            try {
+                size_t chunkBytes = static_cast<size_t>(bounds[c + 1] - bounds[c]);
+                chunks[c].reserve(std::min<size_t>(static_cast<size_t>(edgeCount) / threads, chunkBytes / MIN_EDGE_BYTES) + 16);
+                aligned[c] = scanEdges(bounds[c], bounds[c + 1], chunks[c], file.data());
+            }
+            catch (...) {
+                errors[c] = std::current_exception();
+            }
+        }
+    });
+    for (const std::exception_ptr& error : errors)
+        if (error) std::rethrow_exception(error);
+
+    std::vector<Edge> edges;
+    if (std::find(aligned.begin(), aligned.end(), 0) != aligned.end()) {
+        edges.reserve(std::min<size_t>(static_cast<size_t>(edgeCount), bodySize / MIN_EDGE_BYTES + 1));
+        scanEdges(p, end, edges, file.data());
+    }
+    else {
+        size_t total = 0;
+        for (const std::vector<Edge>& c : chunks) total += c.size();
+        edges.reserve(total);
+        for (std::vector<Edge>& c : chunks) {
+            edges.insert(edges.end(), c.begin(), c.end());
+            std::vector<Edge>().swap(c);
+        }
+    }
+
+    if (edges.size() < static_cast<size_t>(edgeCount)) throw std::runtime_error("Unexpected end of input file");
+    edges.resize(edgeCount);
+    for (const Edge& e : edges)
+        if (e.from < 0 || e.from >= vertices || e.to < 0 || e.to >= vertices)
+            throw std::runtime_error("Vertex id out of range in input file");
+
+    Graph g(vertices, directed, repr);
+    g.setEdges(std::move(edges));
+    return g;
+}
+
+#endif // LOADER_H
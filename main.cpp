@@ -2,9 +2,25 @@
 #include <fstream>
 #include <string>
 #include <cstdlib>
+#include <optional>
+#include <map>
+#include <functional>
 #include "timer.h"
 #include "algorithms.h"
 #include "modes.h"
+#include "benchmark.h"
+#include "batch.h"
+#include "reorder.h"
+#include "typedGraph.h"
+#include "external.h"
+#include "resultWriter.h"
+
+template struct BasicCSRGraph<uint32_t, uint8_t>;
+template struct BasicCSRGraph<uint32_t, int32_t>;
+template struct BasicCSRGraph<uint64_t, int64_t>;
+template class BasicGraphAlgorithms<uint32_t, uint8_t, uint32_t>;
+template class BasicGraphAlgorithms<uint32_t, int32_t, int64_t>;
+template class BasicGraphAlgorithms<uint64_t, int64_t, int64_t>;
 
 void showHelp() {
     std::cout << "PROGRAM GRAFOWY - AiZO Projekt 2\n";
@@ -18,16 +34,34 @@ void showHelp() {
     std::cout << "    algorithm: dla MST:\n";
     std::cout << "                 0 - Prim\n";
     std::cout << "                 1 - Kruskal\n";
+    std::cout << "                 8 - Boruvka (rownolegly, --threads)\n";
     std::cout << "               dla najkrtszej cieki:\n";
     std::cout << "                 2 - Dijkstra\n";
     std::cout << "                 3 - Bellman-Ford\n";
     std::cout << "               dla maksymalnego przepywu:\n";
     std::cout << "                 4 - Ford-Fulkerson\n";
+    std::cout << "                 6 - Dinic\n";
+    std::cout << "                 7 - push-relabel (najwyzsza etykieta)\n";
     std::cout << "    plik_wejsciowy: nazwa pliku z grafem (format zgodny z PDF)\n";
     std::cout << "    plik_wyjsciowy: (opcjonalnie) plik z wynikami\n";
-	std::cout << "    typ wyjcia: (opcjonalnie) 'matrix' lub 'list' (domylnie 'list')\n";
+	std::cout << "    typ wyjcia: (opcjonalnie) 'matrix', 'list' lub 'csr' (domylnie 'list')\n";
     std::cout << "    start, end:  wierzchoki pocztkowy i kocowy dla cieki/przepywu(dla problemu 1 i 2)\n";
 
+    std::cout << "  --convert <plik_wejsciowy> <plik_snapshotu> [directed|undirected]\n";
+    std::cout << "    zapisuje graf tekstowy jako snapshot binarny (CSR + lista krawedzi), ktory --file\n";
+    std::cout << "    rozpoznaje automatycznie i mapuje bez parsowania; skierowanie CSR domyslnie 'directed',\n";
+    std::cout << "    dla MST (problem 0) warto uzyc 'undirected'\n\n";
+
+    std::cout << "  --batch <plik_grafu> <plik_wyjsciowy> [typ wyjscia] --queries=<plik> | --all-pairs\n";
+    std::cout << "    najkrotsze sciezki (Dijkstra) dla wielu zapytan na raz wczytanym grafie skierowanym;\n";
+    std::cout << "    plik zapytan zawiera pary 'zrodlo cel' (cel -1: odleglosci do wszystkich wierzcholkow),\n";
+    std::cout << "    zapytania o wspolnym zrodle obslugiwane jednym przebiegiem, rozdzielane miedzy --threads;\n";
+    std::cout << "    wynik: 's t koszt' lub 's t brak', z --paths rowniez wierzcholki sciezki; zapytania\n";
+    std::cout << "    wypisywane grupami wg zrodla, w kolejnosci jego pierwszego wystapienia w pliku;\n";
+    std::cout << "    --all-pairs wypisuje macierz odleglosci (tylko dla malych grafow); z --search=early|bidir|alt\n";
+    std::cout << "    kazde zapytanie liczone osobno (wyniki w kolejnosci z pliku) na grafie odwrotnym i punktach\n";
+    std::cout << "    orientacyjnych zbudowanych raz - czas przygotowania wypisywany osobno\n\n";
+
     std::cout << "  --test <problem> <algorithm> <liczba_wierzcholkow> <gestosc[%]> <plik_wyjsciowy>\n";
     std::cout << "    problem:  0 - MST(drzewo rozpinajce)\n";
     std::cout << "              1 - najkrtsza cieka\n";
@@ -35,15 +69,89 @@ void showHelp() {
     std::cout << "    algorithm: dla MST:\n";
     std::cout << "                 0 - Prim\n";
     std::cout << "                 1 - Kruskal\n";
+    std::cout << "                 8 - Boruvka (rownolegly, --threads)\n";
     std::cout << "               dla najkrtszej cieki:\n";
     std::cout << "                 2 - Dijkstra\n";
     std::cout << "                 3 - Bellman-Ford\n";
     std::cout << "               dla maksymalnego przepywu:\n";
     std::cout << "                 4 - Ford-Fulkerson\n";
+    std::cout << "                 6 - Dinic\n";
+    std::cout << "                 7 - push-relabel (najwyzsza etykieta)\n";
 	std::cout << "    liczba_wierzcholkow: liczba wierzchokw w grafie\n";
 	std::cout << "    gestosc[%]: procent krawdzi w grafie (0-100)\n";
     std::cout << "    plik_wyjsciowy: (opcjonalnie) plik z wynikami\n";
 
+    std::cout << "  --sweep <problem> <algorithm> <wierzcholki> <gestosci[%]> <plik_wyjsciowy>\n";
+    std::cout << "    siatka pomiarow jak w --test dla wszystkich par (V, gestosc) w jednym wywolaniu; wartosci jako\n";
+    std::cout << "    lista a,b,c lub zakresy od:do:krok i od:do:xk (np. 100:1600:x2 oraz 10:50:20); bez --reorder,\n";
+    std::cout << "    --types, --jobs, --isolate, --pin i --counters\n";
+    std::cout << "    kazda komorka (punkt x przypadek x reprezentacja) z generowaniem grafow w osobnym procesie: po\n";
+    std::cout << "    --timeout-ms=T (domyslnie 60000, 0 - bez limitu) przerywana, wieksze V pomijane; w tabeli CSV\n";
+    std::cout << "    (wiersz dopisywany po kazdej komorce) status, czasy, szczytowe RSS oraz bajty listy sasiedztwa,\n";
+    std::cout << "    macierzy, listy krawedzi i CSR\n\n";
+
+    std::cout << "  --dynamic <problem> <liczba_wierzcholkow> <gestosc[%]> <plik_wyjsciowy>\n";
+    std::cout << "    partie losowych zmian krawedzi (wstawienia, usuniecia, zmiany wag) na grafie z generatora;\n";
+    std::cout << "    problem 0 - MST naprawiane wymiana krawedzi cyklu/przekroju (graf nieskierowany),\n";
+    std::cout << "    problem 1 - najkrotsze sciezki z wierzcholka 0 naprawiane w poddrzewach (graf skierowany);\n";
+    std::cout << "    kazda partia porownywana z pelnym przeliczeniem (Kruskal/Dijkstra), wynik CSV na partie\n";
+    std::cout << "    --batches=N  --batch-size=N   liczba partii (20) i zmian w partii (10)\n\n";
+
+    std::cout << "  Opcje (--nazwa=wartosc, w dowolnym miejscu po trybie):\n";
+    std::cout << "    --prim-queue=auto|array|binary|quad|pairing   kolejka w algorytmie Prima (domyslnie auto)\n";
+    std::cout << "    --kruskal=sort|parallel|filter   wariant Kruskala: sortowanie, sortowanie rownolegle, Filter-Kruskal\n";
+    std::cout << "    --threads=N[,N...]   liczba watkow dla wariantow rownoleglych (domyslnie liczba rdzeni);\n";
+    std::cout << "                         lista w --test mierzy warianty rownolegle dla kazdej wartosci\n";
+    std::cout << "    --dijkstra=heap|dial|radix|delta   kolejka w algorytmie Dijkstry (--test porownuje wszystkie)\n";
+    std::cout << "    --delta=N   szerokosc kubelka w delta-steppingu (domyslnie dobierana automatycznie); zwiekszana,\n";
+    std::cout << "                gdy maksymalna waga / N przekracza 2^20 kubelkow\n";
+    std::cout << "    --bellman-ford=passes|spfa|parallel   wariant Bellmana-Forda (wykrywa i wypisuje ujemny cykl)\n";
+    std::cout << "    --search=full|early|bidir|alt   Dijkstra dla pary start-end: pelne drzewo (domyslnie),\n";
+    std::cout << "                         przerwanie po rozliczeniu celu, wyszukiwanie dwukierunkowe albo A*\n";
+    std::cout << "                         z punktami orientacyjnymi (ALT); w --test i --batch graf odwrotny\n";
+    std::cout << "                         i punkty orientacyjne budowane sa raz na graf i mierzone osobno\n";
+    std::cout << "    --landmarks=N   liczba punktow orientacyjnych dla --search=alt (domyslnie 8)\n";
+    std::cout << "    --pairs=N   w --test i --sweep: zapytania punkt-punkt w jednym przebiegu (0 -> n-1 i losowe pary),\n";
+    std::cout << "                czas na zapytanie; koszt przygotowania w --test w wierszach Index[bidir|alt]\n";
+    std::cout << "    --reorder=none|bfs|rcm|degree|community   przenumerowanie wierzcholkow przed algorytmem\n";
+    std::cout << "                         (BFS, odwrocony Cuthill-McKee, malejaco wg stopnia, spolecznosci);\n";
+    std::cout << "                         --file wypisuje wyniki w numeracji z pliku, --test mierzy koszt\n";
+    std::cout << "                         przenumerowania i przyspieszenie kazdego przypadku\n";
+    std::cout << "    --types=int|auto|u32/u8/u32|u32/i32/i64|u64/i64/i64   typy numerow wierzcholkow, wag i odleglosci\n";
+    std::cout << "                         dla Prima, Kruskala, Dijkstry i Bellmana-Forda (indeks/waga/odleglosc);\n";
+    std::cout << "                         auto wybiera najwezsze mieszczace wczytany graf; --file uzywa ich zamiast\n";
+    std::cout << "                         int (odleglosci bez przepelnienia), --test mierzy je obok wersji int\n";
+    std::cout << "    --simd=auto|scalar|avx2|avx512   jadra wektorowe (skan kluczy w Primie z tablica, wiersze macierzy\n";
+    std::cout << "                         w Bellmanie-Fordzie, BFS w Fordzie-Fulkersonie); domyslnie najlepsze\n";
+    std::cout << "                         dostepne na tym procesorze\n";
+    std::cout << "    --workspace   w --test: Prim, Kruskal, Dijkstra (heap), Bellman-Ford (passes) i Ford-Fulkerson\n";
+    std::cout << "                  uzywaja buforow wspolnych dla wszystkich przebiegow przypadku; liczba alokacji\n";
+    std::cout << "                  na przebieg jest raportowana zawsze\n";
+    std::cout << "    --verify   w --file sprawdza sume kontrolna snapshotu przed uruchomieniem algorytmu, a wynik\n";
+    std::cout << "               zapisany z --result-format=binary odczytuje ponownie i porownuje z obliczonym\n";
+    std::cout << "    --external[=katalog]   w --file: Kruskal (problem 0) i Bellman-Ford (problem 1) bez wczytywania\n";
+    std::cout << "                         listy krawedzi - sortowanie zewnetrzne i przebiegi jako odczyty pliku;\n";
+    std::cout << "                         pliki posrednie w podanym katalogu (domyslnie tymczasowym systemu);\n";
+    std::cout << "                         wymaga pliku wyjsciowego\n";
+    std::cout << "    --memory-mb=N   budzet pamieci na przebiegi sortowania w --external (domyslnie 256)\n";
+    std::cout << "    --result-format=text|binary   plik wynikow --file: tekst (domyslnie) albo binarny (naglowek\n";
+    std::cout << "                         i wyrownane tablice: krawedzie MST, dist/prev, przeplyw z przekrojem)\n";
+    std::cout << "    --model=gnm|gnp|rmat|grid   model grafu w --test: G(n,m) (domyslnie), G(n,p), R-MAT, siatka 2D\n";
+    std::cout << "    --seed=N   ziarno generatora w --test (bez niego losowe i wypisywane na ekran)\n";
+    std::cout << "    --graphs=N  --warmup=N  --repeats=N   w --test: liczba grafow (5), przebiegi rozgrzewkowe (1)\n";
+    std::cout << "                         i mierzone (10) dla kazdego przypadku na kazdym grafie\n";
+    std::cout << "    --budget-ms=T   zamiast --repeats: powtarzaj pomiar, az laczny czas przekroczy T ms\n";
+    std::cout << "    --jobs=N   w --test: N pomiarow (przypadek x reprezentacja x graf) naraz na wspolnych grafach,\n";
+    std::cout << "                         z podbieraniem pracy; kolejnosc wynikow jak przy jednym watku; w wynikach\n";
+    std::cout << "                         srednia liczba nakladajacych sie pomiarow, alokacje tylko watku pomiaru\n";
+    std::cout << "    --isolate   z --jobs: mierzone przebiegi pojedynczo, rownolegle tylko budowa grafow i rozgrzewki\n";
+    std::cout << "    --pin   z --jobs: watek roboczy t przypiety do procesora t (dziedzicza to watki algorytmow)\n";
+    std::cout << "    --format=csv|json   format pliku wynikow --test (domyslnie wg rozszerzenia, inaczej csv);\n";
+    std::cout << "                         min/mediana/srednia/p95/odchylenie w nanosekundach\n";
+    std::cout << "    --counters   w --test: liczniki sprzetowe (cykle, instrukcje, chybienia L1d/LLC, bledne\n";
+    std::cout << "                 przewidywania skokow; Linux perf_event_open) oraz czasy faz, np. sortowanie\n";
+    std::cout << "                 i union-find w Kruskalu, BFS i powiekszanie w Fordzie-Fulkersonie\n\n";
+
     std::cout << "  --help\n";
     std::cout << "    Wywietla t pomoc.\n";
 
@@ -56,10 +164,222 @@ GraphAlgorithmType parseAlgorithm(int alg) {
     case 2: return GraphAlgorithmType::DIJKSTRA;
     case 3: return GraphAlgorithmType::FORD_BELLMAN;
     case 4: return GraphAlgorithmType::FORD_FULKERSON;
+    case 6: return GraphAlgorithmType::DINIC;
+    case 7: return GraphAlgorithmType::PUSH_RELABEL;
+    case 8: return GraphAlgorithmType::BORUVKA;
     default: throw std::invalid_argument("Unknown algorithm id");
     }
 }
 
+PrimQueue parsePrimQueue(const std::string& name) {
+    if (name == "auto") return PrimQueue::AUTO;
+    if (name == "array") return PrimQueue::ARRAY;
+    if (name == "binary") return PrimQueue::BINARY_HEAP;
+    if (name == "quad") return PrimQueue::QUAD_HEAP;
+    if (name == "pairing") return PrimQueue::PAIRING_HEAP;
+    throw std::invalid_argument("Unknown Prim queue: " + name);
+}
+
+// Usuwa z argv opcje --nazwa[=wartosc] wystepujace po trybie i zwraca je jako mape;
+// argumenty pozycyjne zostaja przesuniete tak, by dotychczasowe indeksy argv dalej obowiazywaly
+std::map<std::string, std::string> extractOptions(int& argc, char* argv[]) {
+    std::map<std::string, std::string> options;
+    int kept = std::min(argc, 2);
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            argv[kept++] = argv[i];
+            continue;
+        }
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos) options[arg.substr(2)] = "1";
+        else options[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+    }
+    argc = kept;
+    return options;
+}
+
+KruskalVariant parseKruskalVariant(const std::string& name) {
+    if (name == "sort") return KruskalVariant::SORT;
+    if (name == "parallel") return KruskalVariant::PARALLEL_SORT;
+    if (name == "filter") return KruskalVariant::FILTER;
+    throw std::invalid_argument("Unknown Kruskal variant: " + name);
+}
+
+DijkstraEngine parseDijkstraEngine(const std::string& name) {
+    if (name == "heap") return DijkstraEngine::BINARY_HEAP;
+    if (name == "dial") return DijkstraEngine::DIAL;
+    if (name == "radix") return DijkstraEngine::RADIX_HEAP;
+    if (name == "delta") return DijkstraEngine::DELTA_STEPPING;
+    throw std::invalid_argument("Unknown Dijkstra engine: " + name);
+}
+
+PathSearch parsePathSearch(const std::string& name) {
+    if (name == "full") return PathSearch::FULL;
+    if (name == "early") return PathSearch::EARLY_EXIT;
+    if (name == "bidir") return PathSearch::BIDIRECTIONAL;
+    if (name == "alt") return PathSearch::ALT;
+    throw std::invalid_argument("Unknown path search: " + name);
+}
+
+VertexOrder parseVertexOrder(const std::string& name) {
+    if (name == "none") return VertexOrder::NONE;
+    if (name == "bfs") return VertexOrder::BFS;
+    if (name == "rcm") return VertexOrder::RCM;
+    if (name == "degree") return VertexOrder::DEGREE;
+    if (name == "community") return VertexOrder::COMMUNITY;
+    throw std::invalid_argument("Unknown vertex order: " + name);
+}
+
+SimdLevel parseSimdLevel(const std::string& name) {
+    if (name == "auto") return detectSimdLevel();
+    if (name == "scalar") return SimdLevel::SCALAR;
+    if (name == "avx2") return SimdLevel::AVX2;
+    if (name == "avx512") return SimdLevel::AVX512;
+    throw std::invalid_argument("Unknown SIMD level: " + name);
+}
+
+GraphTypes parseGraphTypes(const std::string& name) {
+    for (GraphTypes types : { GraphTypes::INT, GraphTypes::AUTO, GraphTypes::U32_U8_U32, GraphTypes::U32_I32_I64, GraphTypes::U64_I64_I64 })
+        if (name == graphTypesName(types)) return types;
+    throw std::invalid_argument("Unknown graph types: " + name);
+}
+
+ResultFormat parseResultFormat(const std::string& name) {
+    if (name == "text") return ResultFormat::TEXT;
+    if (name == "binary") return ResultFormat::BINARY;
+    throw std::invalid_argument("Unknown result format: " + name);
+}
+
+// Lista liczb watkow "1,2,4,8"
+std::vector<unsigned> parseThreadCounts(const std::string& value) {
+    std::vector<unsigned> counts;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        counts.push_back(static_cast<unsigned>(std::max(1, std::stoi(item))));
+    if (counts.empty()) throw std::invalid_argument("Empty thread count list");
+    return counts;
+}
+
+BellmanFordEngine parseBellmanFordEngine(const std::string& name) {
+    if (name == "passes") return BellmanFordEngine::PASSES;
+    if (name == "spfa") return BellmanFordEngine::SPFA;
+    if (name == "parallel") return BellmanFordEngine::PARALLEL;
+    throw std::invalid_argument("Unknown Bellman-Ford engine: " + name);
+}
+
+GraphModel parseGraphModel(const std::string& name) {
+    if (name == "gnm") return GraphModel::GNM;
+    if (name == "gnp") return GraphModel::GNP;
+    if (name == "rmat") return GraphModel::RMAT;
+    if (name == "grid") return GraphModel::GRID;
+    throw std::invalid_argument("Unknown graph model: " + name);
+}
+
+// Bez --seed ziarno jest losowe, ale wypisywane, zeby dalo sie powtorzyc przebieg
+GeneratorOptions parseGeneratorOptions(const std::map<std::string, std::string>& options, unsigned threads) {
+    GeneratorOptions result;
+    result.threads = threads;
+    if (options.count("model")) result.model = parseGraphModel(options.at("model"));
+    result.seed = options.count("seed") ? std::stoull(options.at("seed"))
+        : (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    return result;
+}
+
+AlgorithmOptions parseAlgorithmOptions(const std::map<std::string, std::string>& options) {
+    AlgorithmOptions result;
+    for (const std::pair<const std::string, std::string>& opt : options) {
+        if (opt.first == "prim-queue") result.primQueue = parsePrimQueue(opt.second);
+        else if (opt.first == "kruskal") result.kruskal = parseKruskalVariant(opt.second);
+        else if (opt.first == "dijkstra") result.dijkstra = parseDijkstraEngine(opt.second);
+        else if (opt.first == "threads") result.threads = parseThreadCounts(opt.second).front();
+        else if (opt.first == "delta") result.delta = std::stoi(opt.second);
+        else if (opt.first == "bellman-ford") result.bellmanFord = parseBellmanFordEngine(opt.second);
+        else if (opt.first == "search") result.search = parsePathSearch(opt.second);
+        else if (opt.first == "landmarks") result.landmarks = std::max(1, std::stoi(opt.second));
+    }
+    return result;
+}
+
+// Przypadki --test i --sweep: jeden algorytm albo wszystkie (5), kazdy dla listy --threads
+std::vector<TestCase> testCases(int algorithm, const std::map<std::string, std::string>& options, const AlgorithmOptions& algOptions) {
+    // wybr algorytmw
+    std::vector<GraphAlgorithmType> algs;
+    if (algorithm == 5) {
+        algs = {
+            GraphAlgorithmType::PRIM,
+            GraphAlgorithmType::KRUSKAL,
+            GraphAlgorithmType::DIJKSTRA,
+            GraphAlgorithmType::FORD_BELLMAN,
+            GraphAlgorithmType::FORD_FULKERSON,
+            GraphAlgorithmType::DINIC,
+            GraphAlgorithmType::PUSH_RELABEL,
+            GraphAlgorithmType::BORUVKA
+        };
+    }
+    else {
+        algs = { parseAlgorithm(algorithm) };
+    }
+    std::vector<unsigned> threadCounts = options.count("threads")
+        ? parseThreadCounts(options.at("threads")) : std::vector<unsigned>{ algOptions.threads };
+    return buildTestCases(algs, algOptions, threadCounts);
+}
+
+// Opcje pomiaru wspolne dla --test i --sweep (liczba wierzcholkow i gestosc ustawia wywolujacy)
+BenchmarkConfig parseBenchmarkConfig(const std::map<std::string, std::string>& options, const AlgorithmOptions& algOptions) {
+    BenchmarkConfig config;
+    config.generator = parseGeneratorOptions(options, algOptions.threads);
+    if (options.count("graphs")) config.graphs = std::max(1, std::stoi(options.at("graphs")));
+    if (options.count("warmup")) config.warmup = std::max(0, std::stoi(options.at("warmup")));
+    if (options.count("repeats")) config.repeats = std::max(1, std::stoi(options.at("repeats")));
+    if (options.count("budget-ms")) config.budgetMs = std::stod(options.at("budget-ms"));
+    config.counters = options.count("counters") > 0;
+    if (options.count("reorder")) config.reorder = parseVertexOrder(options.at("reorder"));
+    config.workspace = options.count("workspace") > 0;
+    if (options.count("types")) config.types = parseGraphTypes(options.at("types"));
+    if (options.count("jobs")) config.jobs = static_cast<unsigned>(std::max(1, std::stoi(options.at("jobs"))));
+    config.isolate = options.count("isolate") > 0;
+    config.pin = options.count("pin") > 0;
+    if (options.count("pairs")) config.pairs = std::max(1, std::stoi(options.at("pairs")));
+    return config;
+}
+
+// Wartosci siatki --sweep: lista "a,b,c", w ktorej element moze byc zakresem "od:do:krok" (krok dodawany)
+// albo "od:do:xk" (kolejne wartosci mnozone przez k > 1); wynik rosnaco, bez powtorzen
+std::vector<double> parseSweepValues(const std::string& spec) {
+    std::vector<double> values;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t first = item.find(':');
+        if (first == std::string::npos) {
+            values.push_back(std::stod(item));
+            continue;
+        }
+        size_t second = item.find(':', first + 1);
+        if (second == std::string::npos) throw std::invalid_argument("Sweep range must be from:to:step - " + item);
+        double from = std::stod(item.substr(0, first));
+        double to = std::stod(item.substr(first + 1, second - first - 1));
+        std::string step = item.substr(second + 1);
+        bool geometric = !step.empty() && step[0] == 'x';
+        double k = std::stod(geometric ? step.substr(1) : step);
+        if (geometric ? k <= 1 : k <= 0) throw std::invalid_argument("Invalid sweep step - " + item);
+        const double end = to * (1 + 1e-9);
+        if (geometric) {
+            if (from <= 0) throw std::invalid_argument("Geometric sweep range must start above 0 - " + item);
+            for (double v = from; v <= end; v *= k) values.push_back(v);
+        }
+        else {
+            for (int i = 0; from + i * k <= end; ++i) values.push_back(from + i * k);
+        }
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    if (values.empty()) throw std::invalid_argument("Empty sweep value list: " + spec);
+    return values;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         showHelp();
@@ -69,6 +389,10 @@ int main(int argc, char* argv[]) {
     std::string mode = argv[1];
 
     try {
+        std::map<std::string, std::string> options = extractOptions(argc, argv);
+        AlgorithmOptions algOptions = parseAlgorithmOptions(options);
+        if (options.count("simd")) setSimdLevel(parseSimdLevel(options["simd"]));
+
         if (mode == "--help") {
             showHelp();
         }
@@ -77,12 +401,39 @@ int main(int argc, char* argv[]) {
             GraphAlgorithmType alg = parseAlgorithm(std::stoi(argv[3]));
             std::string inputFile = argv[4];
             std::string outputFile = (argc >= 6) ? argv[5] : "";
-            GraphRepresentation repr = (argc == 7 && std::string(argv[6]) == "matrix")
-                ? GraphRepresentation::MATRIX
+            std::string reprName = (argc >= 7) ? argv[6] : "list";
+            GraphRepresentation repr = reprName == "matrix" ? GraphRepresentation::MATRIX
+                : reprName == "csr" ? GraphRepresentation::CSR
                 : GraphRepresentation::LIST;
             
             bool directed = (problem != 0);
-            Graph g = loadGraphFromFile(inputFile, directed, repr);
+            bool verify = options.count("verify") > 0;
+            ResultFormat resultFormat = options.count("result-format") ? parseResultFormat(options["result-format"]) : ResultFormat::TEXT;
+            // --external: krawedzie zostaja na dysku, wczytywany jest tylko naglowek
+            bool external = options.count("external") > 0;
+            ExternalOptions externalOptions;
+            ExternalStats externalStats;
+            if (external) {
+                if (!((problem == 0 && alg == GraphAlgorithmType::KRUSKAL) || (problem == 1 && alg == GraphAlgorithmType::FORD_BELLMAN)))
+                    throw std::invalid_argument("--external supports Kruskal (problem 0) and Bellman-Ford (problem 1)");
+                if (options.count("reorder") || options.count("types"))
+                    throw std::invalid_argument("--external cannot be combined with --reorder or --types");
+                if (isGraphSnapshot(inputFile)) throw std::invalid_argument("--external requires a text edge list");
+                if (outputFile.empty()) throw std::invalid_argument("--external requires an output file");
+                if (options["external"] != "1") externalOptions.scratchDir = options["external"];
+                if (options.count("memory-mb")) {
+                    unsigned long long mb = std::stoull(options["memory-mb"]);
+                    if (mb == 0) throw std::invalid_argument("--memory-mb must be positive");
+                    externalOptions.memoryBytes = static_cast<size_t>(mb) << 20;
+                }
+            }
+            Graph g(0, directed);
+            std::optional<CSRGraph> csr;
+            if (!external) {
+                if (repr == GraphRepresentation::CSR) csr = loadCSRFromFile(inputFile, directed, verify);
+                else g = loadGraphFromFile(inputFile, directed, repr, verify);
+            }
+            int vertexCount = external ? edgeFileVertices(inputFile) : csr ? csr->vertices : g.vertices;
 
             int start = 0, end = 0;
             if (problem == 1 || problem == 2) {
@@ -92,34 +443,62 @@ int main(int argc, char* argv[]) {
                 }
                 start = std::stoi(argv[7]);
                 end = std::stoi(argv[8]);
-                if (start < 0 || start >= g.vertices || end < 0 || end >= g.vertices) {
+                if (start < 0 || start >= vertexCount || end < 0 || end >= vertexCount) {
                     std::cerr << "Bd: start lub end poza zakresem wierzchokw grafu!\n";
                     return 1;
                 }
             }
+            // Przenumerowanie (--reorder): algorytm dziala na nowych numerach, wyniki wracaja do wejsciowych
+            std::optional<VertexPermutation> perm;
+            if (options.count("reorder") && parseVertexOrder(options["reorder"]) != VertexOrder::NONE) {
+                perm = computeVertexOrder(csr ? *csr : CSRGraph(g), parseVertexOrder(options["reorder"]));
+                if (csr) csr = reorderCSR(*csr, *perm);
+                else g = reorderGraph(g, *perm);
+                start = perm->newId(start);
+                end = perm->newId(end);
+            }
+            // --types: MST (Prim, Kruskal) i najkrotsze sciezki (bez --search) na kopii CSR w typach dobranych do grafu
+            GraphTypes types = options.count("types") ? parseGraphTypes(options["types"]) : GraphTypes::INT;
+            std::optional<CSRGraph> typedSource;
+            bool pointToPoint = alg == GraphAlgorithmType::DIJKSTRA && algOptions.search != PathSearch::FULL;
+            bool typedMSTAlgorithm = alg == GraphAlgorithmType::PRIM || alg == GraphAlgorithmType::KRUSKAL;
+            if (types != GraphTypes::INT && ((problem == 0 && typedMSTAlgorithm) || (problem == 1 && !pointToPoint))) {
+                typedSource = csr ? *csr : CSRGraph(g);
+                types = resolveGraphTypes(types, *typedSource);
+                std::cout << "Typy grafu: " << graphTypesName(types) << "\n";
+            }
             if (!outputFile.empty()) {
-                std::ofstream out(outputFile);
+                // --verify z --result-format=binary: zapisany plik odczytywany przez ResultView i porownywany z wynikiem
+                bool readBack = verify && resultFormat == ResultFormat::BINARY;
+                std::function<bool(const ResultView&)> check;
+                std::ofstream file(outputFile, resultFormat == ResultFormat::BINARY ? std::ios::out | std::ios::binary : std::ios::out);
+                if (!file) throw std::runtime_error("Cannot open output file");
+                BufferedWriter out(file);
 
                 if (problem == 0) { // MST
                     if (alg == GraphAlgorithmType::PRIM) {
-                        std::vector<Edge> mst = GraphAlgorithms::primMST(g);
-                        int totalWeight = 0;
-                        for (const Edge& edge : mst) totalWeight += edge.weight;
-                        out << "MST (Prim):\n";
-                        out << "Total weight: " << totalWeight << "\n";
-                        for (const Edge& edge : mst) {
-                            out << edge.from << " " << edge.to << " " << edge.weight << "\n";
-                        }
+                        std::vector<Edge> mst = typedSource ? typedMST(*typedSource, types, alg)
+                            : csr ? GraphAlgorithms::primMST(*csr, algOptions.primQueue)
+                            : GraphAlgorithms::primMST(g, algOptions.primQueue);
+                        if (perm) restoreEdges(mst, *perm);
+                        writeMSTResult(out, resultFormat, "Prim", mst);
+                        if (readBack) check = [mst](const ResultView& view) { return resultMatches(view, mst); };
                     }
                     else if (alg == GraphAlgorithmType::KRUSKAL) {
-                        std::vector<Edge> mst = GraphAlgorithms::kruskalMST(g);
-                        int totalWeight = 0;
-                        for (const Edge& edge : mst) totalWeight += edge.weight;
-                        out << "MST (Kruskal):\n";
-                        out << "Total weight: " << totalWeight << "\n";
-                        for (const Edge& edge : mst) {
-                            out << edge.from << " " << edge.to << " " << edge.weight << "\n";
-                        }
+                        std::vector<Edge> mst = external ? externalKruskalMST(inputFile, externalOptions, &externalStats)
+                            : typedSource ? typedMST(*typedSource, types, alg)
+                            : csr ? GraphAlgorithms::kruskalMST(*csr, algOptions.kruskal, algOptions.threads)
+                            : GraphAlgorithms::kruskalMST(g, algOptions.kruskal, algOptions.threads);
+                        if (perm) restoreEdges(mst, *perm);
+                        writeMSTResult(out, resultFormat, "Kruskal", mst);
+                        if (readBack) check = [mst](const ResultView& view) { return resultMatches(view, mst); };
+                    }
+                    else if (alg == GraphAlgorithmType::BORUVKA) {
+                        std::vector<Edge> mst = csr ? GraphAlgorithms::boruvkaMST(*csr, algOptions.threads)
+                            : GraphAlgorithms::boruvkaMST(g, algOptions.threads);
+                        if (perm) restoreEdges(mst, *perm);
+                        writeMSTResult(out, resultFormat, "Boruvka", mst);
+                        if (readBack) check = [mst](const ResultView& view) { return resultMatches(view, mst); };
                     }
                     /*if (alg == GraphAlgorithmType::KRUSKAL) { //dla 50 razy do testu datasetu
                         const int runs = 50;
@@ -157,34 +536,177 @@ int main(int argc, char* argv[]) {
                 }
                 else if (problem == 1) { // Najkrtsza cieka
                     std::pair<std::vector<int>, std::vector<int>> result;
-                    if (alg == GraphAlgorithmType::DIJKSTRA)
-                        result = GraphAlgorithms::dijkstra(g, start);
-                    else if (alg == GraphAlgorithmType::FORD_BELLMAN)
-                        result = GraphAlgorithms::fordBellman(g, start);
-
-                    out << "Najkrotsza sciezka od " << start << " do " << end << ": ";
-                    if (result.first[end] == std::numeric_limits<int>::max()) {
-                        out << "brak cieki\n";
+                    std::vector<int> negativeCycle;
+                    std::vector<long long> wideDist;  // z --types zamiast result.first (LLONG_MAX - nieosiagalny)
+                    if (pointToPoint) {
+                        // zapytanie punkt-punkt: odleglosc i poprzednicy tylko wzdluz znalezionej sciezki
+                        PathResult p2p = csr ? runPointToPoint(*csr, start, end, algOptions) : runPointToPoint(g, start, end, algOptions);
+                        result.first.assign(vertexCount, std::numeric_limits<int>::max());
+                        result.second.assign(vertexCount, -1);
+                        if (!p2p.path.empty()) result.first[end] = p2p.cost;
+                        for (size_t i = 1; i < p2p.path.size(); ++i) result.second[p2p.path[i]] = p2p.path[i - 1];
                     }
-                    else {
-                        out << "koszt = " << result.first[end] << " | sciezka: ";
-                        // Funkcja wypisujca ciek
-                        std::vector<int> path;
-                        for (int v = end; v != -1; v = result.second[v])
-                            path.push_back(v);
-                        std::reverse(path.begin(), path.end());
-                        for (size_t i = 0; i < path.size(); ++i) {
-                            out << path[i];
-                            if (i + 1 < path.size()) out << " -> ";
+                    else if (typedSource && (alg == GraphAlgorithmType::DIJKSTRA || alg == GraphAlgorithmType::FORD_BELLMAN)) {
+                        WidePaths wide = typedShortestPaths(*typedSource, types, alg, start);
+                        if (wide.negativeCycle) negativeCycle = std::move(wide.cycle);
+                        wideDist = std::move(wide.dist);
+                        result.second = std::move(wide.prev);
+                    }
+                    else if (alg == GraphAlgorithmType::DIJKSTRA)
+                        result = csr ? runDijkstra(*csr, start, algOptions) : runDijkstra(g, start, algOptions);
+                    else if (alg == GraphAlgorithmType::FORD_BELLMAN) {
+                        BellmanFordResult bf = external ? externalBellmanFord(inputFile, start, externalOptions, &externalStats)
+                            : csr ? GraphAlgorithms::bellmanFord(*csr, start, algOptions.bellmanFord, algOptions.threads)
+                            : GraphAlgorithms::bellmanFord(g, start, algOptions.bellmanFord, algOptions.threads);
+                        if (bf.negativeCycle) negativeCycle = bf.cycle;
+                        result = { std::move(bf.dist), std::move(bf.prev) };
+                    }
+                    if (perm) {
+                        result = { restoreVertexValues(result.first, *perm), restorePredecessors(result.second, *perm) };
+                        wideDist = restoreVertexValues(wideDist, *perm);
+                        for (int& v : negativeCycle) v = perm->oldId(v);
+                        start = perm->oldId(start);
+                        end = perm->oldId(end);
+                    }
+
+                    if (resultFormat == ResultFormat::BINARY) {
+                        if (!wideDist.empty()) writePathsBinary(out, start, end, wideDist, result.second, negativeCycle);
+                        else writePathsBinary(out, start, end, result.first, result.second, negativeCycle);
+                        if (readBack) check = [start, end, wideDist, result, negativeCycle](const ResultView& view) {
+                            return !wideDist.empty() ? resultMatches(view, start, end, wideDist, result.second, negativeCycle)
+                                : resultMatches(view, start, end, result.first, result.second, negativeCycle);
+                        };
+                    }
+                    else if (!negativeCycle.empty()) {
+                        out << "Wykryto ujemny cykl: ";
+                        for (size_t i = 0; i < negativeCycle.size(); ++i) {
+                            out << negativeCycle[i];
+                            if (i + 1 < negativeCycle.size()) out << " -> ";
                         }
                         out << "\n";
                     }
+                    else {
+                        out << "Najkrotsza sciezka od " << start << " do " << end << ": ";
+                        long long cost = !wideDist.empty() ? wideDist[end]
+                            : result.first[end] == std::numeric_limits<int>::max() ? std::numeric_limits<long long>::max() : result.first[end];
+                        if (cost == std::numeric_limits<long long>::max()) {
+                            out << "brak cieki\n";
+                        }
+                        else {
+                            out << "koszt = " << cost << " | sciezka: ";
+                            // Funkcja wypisujca ciek
+                            std::vector<int> path;
+                            for (int v = end; v != -1; v = result.second[v])
+                                path.push_back(v);
+                            std::reverse(path.begin(), path.end());
+                            for (size_t i = 0; i < path.size(); ++i) {
+                                out << path[i];
+                                if (i + 1 < path.size()) out << " -> ";
+                            }
+                            out << "\n";
+                        }
+                    }
                 }
                 else if (problem == 2) { // Maksymalny przepyw
-                    int maxFlow = GraphAlgorithms::fordFulkerson(g, start, end);
-                    out << "Maksymalny przeplyw: " << maxFlow << "\n";
+                    if (alg == GraphAlgorithmType::DINIC || alg == GraphAlgorithmType::PUSH_RELABEL) {
+                        MaxFlowResult flow = alg == GraphAlgorithmType::DINIC
+                            ? (csr ? GraphAlgorithms::dinic(*csr, start, end) : GraphAlgorithms::dinic(g, start, end))
+                            : (csr ? GraphAlgorithms::pushRelabel(*csr, start, end) : GraphAlgorithms::pushRelabel(g, start, end));
+                        if (perm) restoreEdges(flow.cutEdges, *perm);
+                        writeFlowResult(out, resultFormat, flow, true);
+                        if (readBack) check = [flow](const ResultView& view) { return resultMatches(view, flow, true); };
+                    }
+                    else {
+                        MaxFlowResult flow;
+                        flow.flow = csr ? GraphAlgorithms::fordFulkerson(*csr, start, end) : GraphAlgorithms::fordFulkerson(g, start, end);
+                        writeFlowResult(out, resultFormat, flow, false);
+                        if (readBack) check = [flow](const ResultView& view) { return resultMatches(view, flow, false); };
+                    }
                 }
+                out.flush();
+                if (check) {
+                    file.close();
+                    if (!file || !check(ResultView(outputFile))) throw std::runtime_error("Result file mismatch after write");
+                }
+            }
+            if (external) {
+                std::cout << "Tryb zewnetrzny: " << externalStats.runs << " przebiegow sortowania, "
+                    << externalStats.mergePasses << " poziomow scalania, " << externalStats.scans << " odczytow listy krawedzi, "
+                    << "odczytano " << externalStats.bytesRead / (1 << 20) << " MB, zapisano "
+                    << externalStats.bytesWritten / (1 << 20) << " MB\n";
+            }
+        }
+        else if (mode == "--convert" && argc >= 4) {
+            // Snapshot binarny z pliku tekstowego; skierowanie decyduje o postaci zapisanego CSR
+            bool directed = !(argc >= 5 && std::string(argv[4]) == "undirected");
+            Timer timer;
+            timer.start();
+            Graph g = loadGraphFromFile(argv[2], directed, GraphRepresentation::LIST);
+            writeGraphSnapshot(argv[3], g);
+            timer.stop();
+            if (!GraphSnapshot(argv[3]).verify()) throw std::runtime_error("Snapshot checksum mismatch after write");
+            std::cout << "Zapisano snapshot " << argv[3] << ": " << g.vertices << " wierzcholkow, "
+                << g.edges.size() << " krawedzi (" << (directed ? "skierowany" : "nieskierowany") << "), "
+                << timer.result() << " ms\n";
+        }
+        else if (mode == "--batch" && argc >= 4) {
+            // Graf wczytany raz, zapytania grupowane wg zrodla i rozdzielane miedzy watki
+            std::string reprName = (argc >= 5) ? argv[4] : "list";
+            GraphRepresentation repr = reprName == "matrix" ? GraphRepresentation::MATRIX
+                : reprName == "csr" ? GraphRepresentation::CSR
+                : GraphRepresentation::LIST;
+            bool allPairs = options.count("all-pairs") > 0;
+            if (!allPairs && !options.count("queries"))
+                throw std::invalid_argument("--batch requires --queries=<file> or --all-pairs");
+
+            Graph g(0, true);
+            std::optional<CSRGraph> csr;
+            if (repr == GraphRepresentation::CSR) csr = loadCSRFromFile(argv[2], true, options.count("verify") > 0);
+            else g = loadGraphFromFile(argv[2], true, repr, options.count("verify") > 0);
+            int vertexCount = csr ? csr->vertices : g.vertices;
+            if ((csr ? weightRange(*csr) : weightRange(g)).first < 0)
+                throw std::invalid_argument("Batch queries use Dijkstra and require non-negative weights");
+            if (allPairs && vertexCount > BATCH_ALL_PAIRS_LIMIT)
+                throw std::invalid_argument("--all-pairs is limited to " + std::to_string(BATCH_ALL_PAIRS_LIMIT) + " vertices");
+
+            std::vector<PathQuery> queries;
+            if (allPairs) queries = allPairsQueries(vertexCount);
+            else queries = loadQueries(options["queries"], vertexCount);
+
+            std::ofstream out(argv[3]);
+            if (!out) throw std::runtime_error("Cannot open output file");
+            bool paths = options.count("paths") > 0;
+            // --search: kazde zapytanie osobno na przygotowaniu (graf odwrotny, punkty orientacyjne) zbudowanym raz
+            bool pointToPoint = algOptions.search != PathSearch::FULL;
+            Timer timer;
+            PathSearchIndex index;
+            if (pointToPoint) {
+                timer.start();
+                index = csr ? buildPathSearchIndex(*csr, algOptions) : buildPathSearchIndex(g, algOptions);
+                timer.stop();
+                std::cout << "Przygotowanie (" << pathSearchName(algOptions.search) << "): " << timer.result() << " ms\n";
             }
+            timer.start();
+            size_t groups = 0;
+            if (pointToPoint) {
+                auto query = [&](int s, int t) {
+                    return csr ? runPointToPoint(*csr, index, s, t, algOptions) : runPointToPoint(g, index, s, t, algOptions);
+                };
+                if (csr) runBatchPointToPoint(*csr, queries, out, algOptions.threads, paths, query);
+                else if (repr == GraphRepresentation::MATRIX) runBatchPointToPoint(g.matrix, queries, out, algOptions.threads, paths, query);
+                else runBatchPointToPoint(g, queries, out, algOptions.threads, paths, query);
+            }
+            else if (csr) groups = runBatchQueries(*csr, queries, out, algOptions.threads, paths);
+            else if (repr == GraphRepresentation::MATRIX) groups = runBatchQueries(g.matrix, queries, out, algOptions.threads, paths);
+            else groups = runBatchQueries(g, queries, out, algOptions.threads, paths);
+            out.close();
+            timer.stop();
+            long long ns = std::max(1LL, timer.resultNs());
+            std::cout << "Zapytania: " << queries.size()
+                << (pointToPoint ? " (" + pathSearchName(algOptions.search) + ")" : " (" + std::to_string(groups) + " zrodel)")
+                << ", watki: " << algOptions.threads
+                << ", czas: " << timer.result() << " ms, "
+                << static_cast<long long>(queries.size() * 1e9 / ns) << " zapytan/s\n";
         }
         else if (mode == "--test" && argc == 7) {
             int problem = std::stoi(argv[2]);
@@ -192,70 +714,71 @@ int main(int argc, char* argv[]) {
             int vertices = std::stoi(argv[4]);
             double density = std::stod(argv[5]) / 100.0;
             std::string outputFile = argv[6];
-            const int count = 50;
-            int start = 0;
-            int end = vertices - 1;
             std::ofstream out(outputFile);
             if (!out) throw std::runtime_error("Cannot open output file");
 
-            // wybr algorytmw
-            std::vector<GraphAlgorithmType> algs;
-            if (algorithm == 5) {
-                algs = {
-                    GraphAlgorithmType::PRIM,
-                    GraphAlgorithmType::KRUSKAL,
-                    GraphAlgorithmType::DIJKSTRA,
-                    GraphAlgorithmType::FORD_BELLMAN,
-                    GraphAlgorithmType::FORD_FULKERSON
-                };
-            }
-            else {
-                algs = { parseAlgorithm(algorithm) };
-            }
-            
-            std::vector<std::vector<std::vector<int>>> allTimes_repr(2);
-            for (int r = 0; r < 2; ++r)
-                allTimes_repr[r].resize(algs.size());
+            std::vector<TestCase> cases = testCases(algorithm, options, algOptions);
 
-            for (int i = 0; i < count; ++i) {
-                for (int repr_id = 0; repr_id < 2; ++repr_id) {
-                    GraphRepresentation repr = (repr_id == 0) ? GraphRepresentation::LIST : GraphRepresentation::MATRIX;
-                    Graph g = generateRandomGraph(vertices, density, true, repr);
-                    std::cout << "Test: " << i << " | " << (repr == GraphRepresentation::LIST ? "LIST" : "MATRIX") << " representation\n";
+            BenchmarkConfig config = parseBenchmarkConfig(options, algOptions);
+            config.vertices = vertices;
+            config.density = density;
+            std::cout << "Ziarno generatora: " << config.generator.seed << ", SIMD: " << simdLevelName(simd().level) << "\n";
+            if (config.jobs > 1)
+                std::cout << "Pomiary rownolegle: " << config.jobs << " watkow" << (config.isolate ? ", przebiegi mierzone pojedynczo" : "")
+                    << (config.pin ? ", przypiete" : "") << "\n";
 
-                    for (size_t j = 0; j < algs.size(); ++j) {
-                        Graph g_copy = g;
+            std::vector<BenchmarkResult> results = runBenchmarks(config, cases);
+            printBenchmarkSummary(std::cout, results);
 
-                        Timer timer;
-                        timer.start();
-                        runAlgorithm(g_copy, algs[j]);
-                        timer.stop();
-
-                        allTimes_repr[repr_id][j].push_back(timer.result());
-                    }
-                }
+            // format wyniku: --format=csv|json, domyslnie wg rozszerzenia pliku (.json), inaczej CSV
+            std::string format = options.count("format") ? options["format"]
+                : (outputFile.size() >= 5 && outputFile.compare(outputFile.size() - 5, 5, ".json") == 0 ? "json" : "csv");
+            if (format == "json") writeBenchmarkJson(out, config, results);
+            else if (format == "csv") writeBenchmarkCsv(out, config, results);
+            else throw std::invalid_argument("Unknown output format: " + format);
+            out.close();
+        }
+        else if (mode == "--sweep" && argc == 7) {
+            // Siatka V x gestosc w jednym wywolaniu; kazda komorka w procesie potomnym z limitem czasu
+            SweepConfig sweep;
+            for (const char* unsupported : { "reorder", "types", "jobs", "isolate", "pin", "counters" })
+                if (options.count(unsupported))
+                    throw std::invalid_argument(std::string("--sweep cannot be combined with --") + unsupported);
+            sweep.base = parseBenchmarkConfig(options, algOptions);
+            for (double v : parseSweepValues(argv[4])) {
+                if (v < 2) throw std::invalid_argument("Sweep vertex counts must be at least 2");
+                sweep.vertices.push_back(static_cast<int>(std::llround(v)));
             }
-
-            // ZAPIS WYNIKW
-            out << "LIST:\n";
-            for (int i = 0; i < count; ++i) {
-                for (size_t j = 0; j < allTimes_repr[0].size(); ++j) {
-                    out << allTimes_repr[0][j][i];
-                    if (j != allTimes_repr[0].size() - 1) out << "\t";
-                }
-                out << "\n";
+            sweep.vertices.erase(std::unique(sweep.vertices.begin(), sweep.vertices.end()), sweep.vertices.end());
+            for (double d : parseSweepValues(argv[5])) {
+                if (d <= 0 || d > 100) throw std::invalid_argument("Sweep densities must be in (0, 100]");
+                sweep.densities.push_back(d / 100.0);
             }
+            if (options.count("timeout-ms")) sweep.timeoutMs = std::max(0.0, std::stod(options["timeout-ms"]));
+            std::vector<TestCase> cases = testCases(std::stoi(argv[3]), options, algOptions);
+            std::ofstream out(argv[6]);
+            if (!out) throw std::runtime_error("Cannot open output file");
+            std::cout << "Ziarno generatora: " << sweep.base.generator.seed << ", siatka " << sweep.vertices.size() << " x "
+                << sweep.densities.size() << ", limit " << sweep.timeoutMs << " ms na komorke\n";
 
-            out << "\nMATRIX:\n";
-            for (int i = 0; i < count; ++i) {
-                for (size_t j = 0; j < allTimes_repr[1].size(); ++j) {
-                    out << allTimes_repr[1][j][i];
-                    if (j != allTimes_repr[1].size() - 1) out << "\t";
-                }
-                out << "\n";
-            }
+            runSweep(sweep, cases, out);
+        }
+        else if (mode == "--dynamic" && argc == 6) {
+            DynamicBenchmarkConfig config;
+            config.problem = std::stoi(argv[2]);
+            if (config.problem != 0 && config.problem != 1) throw std::invalid_argument("--dynamic supports problem 0 (MST) or 1 (shortest paths)");
+            config.vertices = std::stoi(argv[3]);
+            config.density = std::stod(argv[4]) / 100.0;
+            config.generator = parseGeneratorOptions(options, algOptions.threads);
+            if (options.count("batches")) config.batches = std::max(1, std::stoi(options["batches"]));
+            if (options.count("batch-size")) config.batchSize = std::max(1, std::stoi(options["batch-size"]));
+            std::ofstream out(argv[5]);
+            if (!out) throw std::runtime_error("Cannot open output file");
+            std::cout << "Ziarno generatora: " << config.generator.seed << "\n";
 
-            out.close();
+            std::vector<DynamicBatchResult> results = runDynamicBenchmark(config);
+            printDynamicSummary(std::cout, results);
+            writeDynamicCsv(out, config, results);
         }
         else {
             std::cerr << "Invalid arguments\n";
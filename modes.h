@@ -8,63 +8,261 @@
 #include <algorithm>
 #include <stdexcept>
 #include <sstream>
+#include <optional>
 #include "algorithms.h"
 #include "timer.h"
+#include "loader.h"
+#include "snapshot.h"
+#include "generator.h"
+#include "typedGraph.h"
+#include "resultWriter.h"
 
-Graph loadGraphFromFile(const std::string& filename, bool directed, GraphRepresentation repr) {
-    std::ifstream in(filename);
-    if (!in) throw std::runtime_error("Cannot open input file");
-    int edges, vertices;
-    in >> edges >> vertices;
-    Graph g(vertices, directed, repr);
-    for (int i = 0; i < edges; ++i) {
-        int u, v, w;
-        in >> u >> v >> w;
-        g.addEdge(u, v, w);
+// Ustawienia wariantow algorytmow wybierane z linii polecen
+struct AlgorithmOptions {
+    PrimQueue primQueue = PrimQueue::AUTO;
+    KruskalVariant kruskal = KruskalVariant::SORT;
+    unsigned threads = defaultThreadCount();
+    DijkstraEngine dijkstra = DijkstraEngine::BINARY_HEAP;
+    int delta = 0;  // delta-stepping, 0 - automatycznie
+    BellmanFordEngine bellmanFord = BellmanFordEngine::PASSES;
+    PathSearch search = PathSearch::FULL;
+    int landmarks = 8;  // ALT
+};
+
+// Pojedyncza kolumna pomiarow w trybie --test
+struct TestCase {
+    std::string name;
+    GraphAlgorithmType algorithm;
+    AlgorithmOptions options;
+    int scalingBase = -1;  // przypadek z pierwsza liczba watkow tej samej serii (--threads=N,N...); -1 - poza seria
+};
+
+std::string algorithmName(GraphAlgorithmType alg) {
+    switch (alg) {
+    case GraphAlgorithmType::PRIM: return "Prim";
+    case GraphAlgorithmType::KRUSKAL: return "Kruskal";
+    case GraphAlgorithmType::DIJKSTRA: return "Dijkstra";
+    case GraphAlgorithmType::FORD_BELLMAN: return "Bellman-Ford";
+    case GraphAlgorithmType::FORD_FULKERSON: return "Ford-Fulkerson";
+    case GraphAlgorithmType::DINIC: return "Dinic";
+    case GraphAlgorithmType::PUSH_RELABEL: return "Push-relabel";
+    case GraphAlgorithmType::BORUVKA: return "Boruvka";
     }
-    return g;
+    return "?";
 }
 
-Graph generateRandomGraph(int vertices, double density, bool directed, GraphRepresentation repr) {
-    int maxEdges = directed ? vertices * (vertices - 1) : vertices * (vertices - 1) / 2;
-    int edgeCount = static_cast<int>(maxEdges * density);
+std::string representationName(GraphRepresentation repr) {
+    switch (repr) {
+    case GraphRepresentation::LIST: return "LIST";
+    case GraphRepresentation::MATRIX: return "MATRIX";
+    case GraphRepresentation::CSR: return "CSR";
+    }
+    return "?";
+}
 
-    Graph g(vertices, directed, repr);
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<int> weightDist(1, 100);
-
-    std::vector<std::pair<int, int>> possibleEdges;
-    for (int i = 0; i < vertices; ++i) {
-        for (int j = 0; j < vertices; ++j) {
-            if (i != j && (directed || i < j)) {
-                possibleEdges.emplace_back(i, j);
-            }
+std::string graphModelName(GraphModel model) {
+    switch (model) {
+    case GraphModel::GNM: return "gnm";
+    case GraphModel::GNP: return "gnp";
+    case GraphModel::RMAT: return "rmat";
+    case GraphModel::GRID: return "grid";
+    }
+    return "?";
+}
+
+std::string dijkstraEngineName(DijkstraEngine engine) {
+    switch (engine) {
+    case DijkstraEngine::BINARY_HEAP: return "heap";
+    case DijkstraEngine::DIAL: return "dial";
+    case DijkstraEngine::RADIX_HEAP: return "radix";
+    case DijkstraEngine::DELTA_STEPPING: return "delta";
+    }
+    return "?";
+}
+
+std::string pathSearchName(PathSearch search) {
+    switch (search) {
+    case PathSearch::FULL: return "full";
+    case PathSearch::EARLY_EXIT: return "early";
+    case PathSearch::BIDIRECTIONAL: return "bidir";
+    case PathSearch::ALT: return "alt";
+    }
+    return "?";
+}
+
+// Dijkstra rozwijany jest na wszystkie kolejki, aby porownac je w jednym przebiegu (przy --search
+// innym niz full mierzone jest tylko zapytanie punkt-punkt);
+// warianty rownolegle powtarzane sa dla kazdej liczby watkow z threadCounts (krzywa przyspieszenia)
+std::vector<TestCase> buildTestCases(const std::vector<GraphAlgorithmType>& algs, const AlgorithmOptions& base,
+    const std::vector<unsigned>& threadCounts) {
+    std::vector<TestCase> cases;
+    auto addParallel = [&](const TestCase& tc) {
+        if (threadCounts.size() <= 1) {
+            cases.push_back(tc);
+            return;
+        }
+        const int base = static_cast<int>(cases.size());
+        for (unsigned t : threadCounts) {
+            TestCase scaled = tc;
+            scaled.name += "/t" + std::to_string(t);
+            scaled.options.threads = t;
+            scaled.scalingBase = base;
+            cases.push_back(scaled);
         }
+    };
+
+    for (GraphAlgorithmType alg : algs) {
+        if (alg == GraphAlgorithmType::KRUSKAL && base.kruskal != KruskalVariant::SORT) {
+            addParallel({ algorithmName(alg), alg, base });
+            continue;
+        }
+        if (alg == GraphAlgorithmType::BORUVKA ||
+            (alg == GraphAlgorithmType::FORD_BELLMAN && base.bellmanFord == BellmanFordEngine::PARALLEL)) {
+            addParallel({ algorithmName(alg), alg, base });
+            continue;
+        }
+        if (alg != GraphAlgorithmType::DIJKSTRA) {
+            cases.push_back({ algorithmName(alg), alg, base });
+            continue;
+        }
+        if (base.search != PathSearch::FULL) {
+            cases.push_back({ algorithmName(alg) + "[" + pathSearchName(base.search) + "]", alg, base });
+            continue;
+        }
+        for (DijkstraEngine engine : { DijkstraEngine::BINARY_HEAP, DijkstraEngine::DIAL, DijkstraEngine::RADIX_HEAP, DijkstraEngine::DELTA_STEPPING }) {
+            TestCase tc{ algorithmName(alg) + "[" + dijkstraEngineName(engine) + "]", alg, base };
+            tc.options.dijkstra = engine;
+            if (engine == DijkstraEngine::DELTA_STEPPING) addParallel(tc);
+            else cases.push_back(tc);
+        }
+    }
+    return cases;
+}
+
+// Dijkstra z kolejka wybrana w opcjach; delta-stepping dostaje delte i liczbe watkow
+template <typename G>
+std::pair<std::vector<int>, std::vector<int>> runDijkstra(const G& g, int start, const AlgorithmOptions& options) {
+    if (options.dijkstra == DijkstraEngine::DELTA_STEPPING)
+        return GraphAlgorithms::deltaStepping(g, start, options.delta, options.threads);
+    return GraphAlgorithms::dijkstra(g, start, options.dijkstra);
+}
+
+// Przygotowanie zapytan punkt-punkt wg options.search, budowane raz dla grafu i wspolne dla kolejnych zapytan
+// (rowniez z wielu watkow - po zbudowaniu tylko do odczytu): graf odwrotny dla bidir i alt na grafie
+// skierowanym (nieskierowany jest sam dla siebie odwrotny) oraz punkty orientacyjne dla alt
+struct PathSearchIndex {
+    std::optional<CSRGraph> reverse;
+    std::optional<Landmarks> landmarks;
+};
+
+bool needsPathSearchIndex(const AlgorithmOptions& options) {
+    return options.search == PathSearch::BIDIRECTIONAL || options.search == PathSearch::ALT;
+}
+
+template <typename G>
+PathSearchIndex buildPathSearchIndex(const G& forward, std::optional<CSRGraph> reverse, const AlgorithmOptions& options) {
+    PathSearchIndex index;
+    if (options.search == PathSearch::ALT)
+        index.landmarks = reverse ? GraphAlgorithms::selectLandmarks(forward, *reverse, options.landmarks)
+            : GraphAlgorithms::selectLandmarks(forward, forward, options.landmarks);
+    index.reverse = std::move(reverse);
+    return index;
+}
+
+PathSearchIndex buildPathSearchIndex(const Graph& g, const AlgorithmOptions& options) {
+    if (!needsPathSearchIndex(options)) return {};
+    std::optional<CSRGraph> reverse;
+    if (g.directed) reverse = CSRGraph(g).reversed();
+    return g.representation == GraphRepresentation::MATRIX ? buildPathSearchIndex(g.matrix, std::move(reverse), options)
+        : buildPathSearchIndex(g, std::move(reverse), options);
+}
+
+PathSearchIndex buildPathSearchIndex(const CSRGraph& g, const AlgorithmOptions& options) {
+    if (!needsPathSearchIndex(options)) return {};
+    std::optional<CSRGraph> reverse;
+    if (g.directed) reverse = g.reversed();
+    return buildPathSearchIndex(g, std::move(reverse), options);
+}
+
+template <typename G>
+PathResult pointToPointQuery(const G& g, const PathSearchIndex& index, int source, int target, const AlgorithmOptions& options) {
+    if (options.search == PathSearch::BIDIRECTIONAL)
+        return index.reverse ? GraphAlgorithms::bidirectionalDijkstra(g, *index.reverse, source, target)
+            : GraphAlgorithms::bidirectionalDijkstra(g, g, source, target);
+    if (options.search == PathSearch::ALT) {
+        const Landmarks& landmarks = *index.landmarks;
+        return GraphAlgorithms::aStar(g, source, target, [&](int v) { return landmarks.lowerBound(v, target); });
     }
-    std::shuffle(possibleEdges.begin(), possibleEdges.end(), rng);
-    for (int i = 0; i < edgeCount && i < static_cast<int>(possibleEdges.size()); ++i) {
-        int u = possibleEdges[i].first;
-        int v = possibleEdges[i].second;
-        int w = weightDist(rng);
-        g.addEdge(u, v, w);
+    return GraphAlgorithms::aStar(g, source, target, [](int) { return 0; });
+}
+
+// Zapytanie punkt-punkt wg options.search na przygotowaniu z buildPathSearchIndex dla tego grafu i tych opcji
+PathResult runPointToPoint(const Graph& g, const PathSearchIndex& index, int source, int target, const AlgorithmOptions& options) {
+    return g.representation == GraphRepresentation::MATRIX ? pointToPointQuery(g.matrix, index, source, target, options)
+        : pointToPointQuery(g, index, source, target, options);
+}
+
+PathResult runPointToPoint(const CSRGraph& g, const PathSearchIndex& index, int source, int target, const AlgorithmOptions& options) {
+    return pointToPointQuery(g, index, source, target, options);
+}
+
+// Pojedyncze zapytanie (--file): przygotowanie budowane tylko dla niego
+template <typename G>
+PathResult runPointToPoint(const G& g, int source, int target, const AlgorithmOptions& options) {
+    return runPointToPoint(g, buildPathSearchIndex(g, options), source, target, options);
+}
+
+// Format (tekstowy lub snapshot binarny) rozpoznawany po naglowku pliku
+Graph loadGraphFromFile(const std::string& filename, bool directed, GraphRepresentation repr, bool verify = false) {
+    if (isGraphSnapshot(filename)) {
+        GraphSnapshot snapshot(filename);
+        if (verify && !snapshot.verify()) throw std::runtime_error("Snapshot checksum mismatch");
+        return snapshot.toGraph(directed, repr);
+    }
+    return loadGraphFast(filename, directed, repr);
+}
+
+// Ze snapshotu o zgodnym skierowaniu CSR jest widokiem na zmapowany plik - bez budowania Graph
+CSRGraph loadCSRFromFile(const std::string& filename, bool directed, bool verify = false) {
+    if (isGraphSnapshot(filename)) {
+        GraphSnapshot snapshot(filename);
+        if (verify && !snapshot.verify()) throw std::runtime_error("Snapshot checksum mismatch");
+        return snapshot.csr(directed);
     }
+    return CSRGraph(loadGraphFast(filename, directed, GraphRepresentation::LIST));
+}
+
+// Losowy graf wg modelu z gen (domyslnie G(n, m) jak dawniej); pamiec i czas O(V + E)
+Graph generateRandomGraph(int vertices, double density, bool directed, GraphRepresentation repr, const GeneratorOptions& gen = {}) {
+    Graph g(vertices, directed, repr);
+    g.setEdges(generateEdges(vertices, density, directed, gen));
     return g;
 }
 
-std::string formatGraphOutput(const Graph& g, const std::string& format = "") {
-    std::ostringstream out;
+CSRGraph generateRandomCSR(int vertices, double density, bool directed, const GeneratorOptions& gen = {}) {
+    return CSRGraph(vertices, directed, generateEdges(vertices, density, directed, gen));
+}
+
+// Ziarno kolejnej proby w --test: rozne grafy w probach, ten sam graf dla wszystkich reprezentacji jednej proby
+uint64_t trialSeed(uint64_t seed, int trial) {
+    uint64_t state = seed + static_cast<uint64_t>(trial);
+    return splitMix64(state);
+}
+
+// Graf strumieniowo przez bufor wyjscia - bez skladania calego tekstu (macierz incydencji V x E) w pamieci
+void writeGraphOutput(BufferedWriter& out, const Graph& g, const std::string& format = "") {
     out << "Wierzcholki: " << g.vertices << "\n";
     out << "Krawedzie: " << g.edges.size() << "\n";
     for (const Edge& edge : g.edges) {
         out << edge.from << " -> " << edge.to << " [" << edge.weight << "]\n";
     }
 
-    if ((format == "matrix" || (format.empty() && g.representation == GraphRepresentation::MATRIX)) && !g.incidenceMatrix.empty()) {
+    if ((format == "matrix" || (format.empty() && g.representation == GraphRepresentation::MATRIX)) && !g.edges.empty()) {
         out << "\nMacierz:\n";
-        for (const std::vector<int>& row : g.incidenceMatrix) {
-            for (int val : row)
-                out << val << " ";
-            out << "\n";
+        for (int u = 0; u < g.vertices; ++u) {
+            for (int idx = 0; idx < static_cast<int>(g.edges.size()); ++idx)
+                out << g.incidence(u, idx) << ' ';
+            out << '\n';
         }
     }
     else if (format == "list" || (format.empty() && g.representation == GraphRepresentation::LIST)) {
@@ -72,36 +270,171 @@ std::string formatGraphOutput(const Graph& g, const std::string& format = "") {
         for (int i = 0; i < g.vertices; ++i) {
             out << i << ": ";
             for (const std::pair<int, int>& p : g.adjList[i]) {
-                out << "(" << p.first << ", " << p.second << ") ";
+                out << '(' << p.first << ", " << p.second << ") ";
             }
-            out << "\n";
+            out << '\n';
         }
     }
-    return out.str();
 }
 
-void runAlgorithm(const Graph& g, GraphAlgorithmType alg, const std::string& outputFile = "") {
+// Wartosc kontrolna wyniku (waga MST, odleglosc do ostatniego wierzcholka, przeplyw) -
+// zwracana, zeby kompilator nie mogl pominac mierzonego wywolania, i do porownan miedzy wariantami
+long long totalWeight(const std::vector<Edge>& edges) {
+    long long sum = 0;
+    for (const Edge& e : edges) sum += e.weight;
+    return sum;
+}
+
+long long distanceTo(const std::vector<int>& dist, int v) {
+    return dist.empty() ? 0 : dist[v];
+}
+
+// Z workspace algorytmy, ktore maja wariant z AlgorithmWorkspace (Prim z kopcem binarnym, Kruskal, Dijkstra
+// z kopcem, Bellman-Ford PASSES, Ford-Fulkerson), uzywaja jego buforow zamiast alokowac przy kazdym wywolaniu
+bool usesWorkspace(GraphAlgorithmType alg, const AlgorithmOptions& options) {
+    switch (alg) {
+    case GraphAlgorithmType::PRIM:
+        // AUTO wybiera kopiec 4-arny albo tablice (choosePrimQueue), a nie leniwy kopiec z przestrzeni roboczej
+        return options.primQueue == PrimQueue::BINARY_HEAP;
+    case GraphAlgorithmType::KRUSKAL:
+    case GraphAlgorithmType::FORD_FULKERSON:
+        return true;
+    case GraphAlgorithmType::DIJKSTRA:
+        return options.search == PathSearch::FULL && options.dijkstra == DijkstraEngine::BINARY_HEAP;
+    case GraphAlgorithmType::FORD_BELLMAN:
+        return options.bellmanFord == BellmanFordEngine::PASSES;
+    default:
+        return false;
+    }
+}
+
+template <typename G>
+long long runWithWorkspace(const G& g, GraphAlgorithmType alg, const AlgorithmOptions& options, int source, int sink, AlgorithmWorkspace& ws) {
+    switch (alg) {
+    case GraphAlgorithmType::PRIM:
+        return totalWeight(GraphAlgorithms::primMST(g, ws));
+    case GraphAlgorithmType::KRUSKAL:
+        return totalWeight(GraphAlgorithms::kruskalMST(g, ws, options.kruskal, options.threads));
+    case GraphAlgorithmType::DIJKSTRA:
+        return distanceTo(GraphAlgorithms::dijkstra(g, source, ws).dist, sink);
+    case GraphAlgorithmType::FORD_BELLMAN:
+        return distanceTo(GraphAlgorithms::bellmanFord(g, source, ws).dist, sink);
+    case GraphAlgorithmType::FORD_FULKERSON:
+        return GraphAlgorithms::fordFulkerson(g, source, sink, ws);
+    default:
+        return 0;
+    }
+}
+
+// Przypadki --test powtarzane na BasicCSRGraph (--types): Prim, Kruskal z sortowaniem, Dijkstra z kopcem
+// (pelne drzewo) i Bellman-Ford PASSES
+bool hasTypedVariant(GraphAlgorithmType alg, const AlgorithmOptions& options) {
+    switch (alg) {
+    case GraphAlgorithmType::PRIM:
+        return true;
+    case GraphAlgorithmType::KRUSKAL:
+        return options.kruskal == KruskalVariant::SORT;
+    case GraphAlgorithmType::DIJKSTRA:
+        return options.search == PathSearch::FULL && options.dijkstra == DijkstraEngine::BINARY_HEAP;
+    case GraphAlgorithmType::FORD_BELLMAN:
+        return options.bellmanFord == BellmanFordEngine::PASSES;
+    default:
+        return false;
+    }
+}
+
+// Wartosc kontrolna jak w runAlgorithm - nieosiagalny cel daje INT_MAX, tak jak w wersji int
+template <typename A>
+long long runTypedAlgorithm(const typename A::CSR& g, GraphAlgorithmType alg, int source, int sink) {
+    using Index = typename A::IndexType;
+    auto distance = [&](const typename A::Paths& paths) {
+        auto d = paths.dist[static_cast<Index>(sink)];
+        return d == A::INF ? static_cast<long long>(std::numeric_limits<int>::max()) : static_cast<long long>(d);
+    };
+    switch (alg) {
+    case GraphAlgorithmType::PRIM:
+        return static_cast<long long>(A::totalWeight(A::primMST(g)));
+    case GraphAlgorithmType::KRUSKAL:
+        return static_cast<long long>(A::totalWeight(A::kruskalMST(g)));
+    case GraphAlgorithmType::DIJKSTRA:
+        return distance(A::dijkstra(g, static_cast<Index>(source)));
+    case GraphAlgorithmType::FORD_BELLMAN:
+        return distance(A::bellmanFord(g, static_cast<Index>(source)));
+    default:
+        return 0;
+    }
+}
+
+long long runAlgorithm(const Graph& g, GraphAlgorithmType alg, const AlgorithmOptions& options = {}, int source = 0, int sink = -1,
+    AlgorithmWorkspace* workspace = nullptr, const std::string& outputFile = "") {
+    if (sink < 0) sink = g.vertices - 1;
+    if (workspace && usesWorkspace(alg, options)) return runWithWorkspace(g, alg, options, source, sink, *workspace);
     std::ostringstream results;
+    long long digest = 0;
     switch (alg) {
     case GraphAlgorithmType::PRIM:
-        GraphAlgorithms::primMST(g);
+        digest = totalWeight(GraphAlgorithms::primMST(g, options.primQueue));
+        break;
     case GraphAlgorithmType::KRUSKAL:
-        GraphAlgorithms::kruskalMST(g);
+        digest = totalWeight(GraphAlgorithms::kruskalMST(g, options.kruskal, options.threads));
+        break;
     case GraphAlgorithmType::DIJKSTRA:
-        GraphAlgorithms::dijkstra(g, 0);
+        digest = options.search == PathSearch::FULL ? distanceTo(runDijkstra(g, source, options).first, sink)
+            : runPointToPoint(g, source, sink, options).cost;
+        break;
     case GraphAlgorithmType::FORD_BELLMAN:
-        GraphAlgorithms::fordBellman(g, 0);
+        digest = distanceTo(GraphAlgorithms::bellmanFord(g, source, options.bellmanFord, options.threads).dist, sink);
+        break;
     case GraphAlgorithmType::FORD_FULKERSON:
-        GraphAlgorithms::fordFulkerson(const_cast<Graph&>(g), 0, g.vertices - 1);
+        digest = GraphAlgorithms::fordFulkerson(const_cast<Graph&>(g), source, sink);
+        break;
+    case GraphAlgorithmType::DINIC:
+        digest = GraphAlgorithms::dinic(g, source, sink).flow;
+        break;
+    case GraphAlgorithmType::PUSH_RELABEL:
+        digest = GraphAlgorithms::pushRelabel(g, source, sink).flow;
+        break;
+    case GraphAlgorithmType::BORUVKA:
+        digest = totalWeight(GraphAlgorithms::boruvkaMST(g, options.threads));
+        break;
     }
 
     if (!outputFile.empty()) {
-        std::ofstream out(outputFile);
-        if (!out) throw std::runtime_error("Cannot write to output file");
-        out << formatGraphOutput(g);
+        std::ofstream file(outputFile);
+        if (!file) throw std::runtime_error("Cannot write to output file");
+        BufferedWriter out(file);
+        writeGraphOutput(out, g);
         out << "\nResult:\n";
         out << results.str() << "\n";
+        out.flush();
+    }
+    return digest;
+}
+
+long long runAlgorithm(const CSRGraph& g, GraphAlgorithmType alg, const AlgorithmOptions& options = {}, int source = 0, int sink = -1,
+    AlgorithmWorkspace* workspace = nullptr) {
+    if (sink < 0) sink = g.vertices - 1;
+    if (workspace && usesWorkspace(alg, options)) return runWithWorkspace(g, alg, options, source, sink, *workspace);
+    switch (alg) {
+    case GraphAlgorithmType::PRIM:
+        return totalWeight(GraphAlgorithms::primMST(g, options.primQueue));
+    case GraphAlgorithmType::KRUSKAL:
+        return totalWeight(GraphAlgorithms::kruskalMST(g, options.kruskal, options.threads));
+    case GraphAlgorithmType::DIJKSTRA:
+        if (options.search != PathSearch::FULL) return runPointToPoint(g, source, sink, options).cost;
+        return distanceTo(runDijkstra(g, source, options).first, sink);
+    case GraphAlgorithmType::FORD_BELLMAN:
+        return distanceTo(GraphAlgorithms::bellmanFord(g, source, options.bellmanFord, options.threads).dist, sink);
+    case GraphAlgorithmType::FORD_FULKERSON:
+        return GraphAlgorithms::fordFulkerson(g, source, sink);
+    case GraphAlgorithmType::DINIC:
+        return GraphAlgorithms::dinic(g, source, sink).flow;
+    case GraphAlgorithmType::PUSH_RELABEL:
+        return GraphAlgorithms::pushRelabel(g, source, sink).flow;
+    case GraphAlgorithmType::BORUVKA:
+        return totalWeight(GraphAlgorithms::boruvkaMST(g, options.threads));
     }
+    return 0;
 }
 
 #endif // MODES_H
@@ -0,0 +1,182 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Liczba watkow sprzetowych (co najmniej 1)
+unsigned defaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Dzieli zakres [0, n) na 'threads' ciaglych blokow i wywoluje fn(begin, end, threadId) w osobnych watkach
+template <typename Fn>
+void parallelForBlocks(size_t n, unsigned threads, Fn&& fn) {
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(n, 1))));
+    if (threads == 1) {
+        fn(size_t{ 0 }, n, 0u);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t chunk = (n + threads - 1) / threads;
+    for (unsigned t = 1; t < threads; ++t) {
+        size_t begin = std::min(n, t * chunk);
+        size_t end = std::min(n, begin + chunk);
+        workers.emplace_back([&fn, begin, end, t] { fn(begin, end, t); });
+    }
+    fn(size_t{ 0 }, std::min(n, chunk), 0u);
+    for (std::thread& w : workers) w.join();
+}
+
+// Indeksy [0, n) pobierane ze wspolnego licznika przez 'threads' watkow: fn(i, threadId).
+// Dla zadan o roznym koszcie, przy ktorych staly podzial na bloki zostawialby watki bez pracy.
+// Pierwszy wyjatek z fn konczy rozdawanie indeksow i jest rzucany ponownie po zakonczeniu watkow.
+template <typename Fn>
+void parallelForDynamic(size_t n, unsigned threads, Fn&& fn) {
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(n, 1))));
+    std::atomic<size_t> next{ 0 };
+    std::exception_ptr error;
+    std::mutex errorLock;
+    auto worker = [&](unsigned t) {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < n; i = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                fn(i, t);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(errorLock);
+                if (!error) error = std::current_exception();
+                next.store(n, std::memory_order_relaxed);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(worker, t);
+    worker(0u);
+    for (std::thread& w : workers) w.join();
+    if (error) std::rethrow_exception(error);
+}
+
+// Przypina biezacy watek do cpu-tego (modulo) procesora dozwolonego dla procesu; poza Linuksem nic nie robi.
+// Watki uruchomione pozniej przez ten watek dziedzicza przypiecie.
+inline void pinCurrentThread(unsigned cpu) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) return;
+    unsigned target = cpu % static_cast<unsigned>(CPU_COUNT(&allowed));
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (!CPU_ISSET(c, &allowed) || target-- != 0) continue;
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(c, &one);
+        pthread_setaffinity_np(pthread_self(), sizeof(one), &one);
+        return;
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+// Zadania [0, n) rozdane na przemian do kolejek 'threads' watkow: kazdy wykonuje swoje od najmniejszego
+// indeksu, a po ich wyczerpaniu podbiera z konca kolejek pozostalych. fn(i, threadId); przy pin watek t
+// przypiety jest do procesora t. Dla zadan grubych (milisekundy i wiecej) - kolejki chronione mutexem.
+// Przy jednym watku zadania wykonywane sa po kolei w biezacym watku (bez przypinania). Pierwszy wyjatek
+// z fn przerywa pobieranie kolejnych zadan i jest rzucany ponownie po zakonczeniu watkow.
+template <typename Fn>
+void parallelForStealing(size_t n, unsigned threads, Fn&& fn, bool pin = false) {
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(n, 1))));
+    if (threads == 1) {
+        for (size_t i = 0; i < n; ++i) fn(i, 0u);
+        return;
+    }
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::deque<size_t> items;
+    };
+    std::vector<Queue> queues(threads);
+    for (size_t i = 0; i < n; ++i) queues[i % threads].items.push_back(i);
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+    std::mutex errorLock;
+
+    auto take = [&](unsigned t, size_t& i) {
+        {
+            std::lock_guard<std::mutex> guard(queues[t].lock);
+            if (!queues[t].items.empty()) {
+                i = queues[t].items.front();
+                queues[t].items.pop_front();
+                return true;
+            }
+        }
+        for (unsigned k = 1; k < threads; ++k) {
+            Queue& victim = queues[(t + k) % threads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.items.empty()) {
+                i = victim.items.back();
+                victim.items.pop_back();
+                return true;
+            }
+        }
+        return false;
+    };
+    auto worker = [&](unsigned t) {
+        if (pin) pinCurrentThread(t);
+        size_t i;
+        while (!failed.load(std::memory_order_relaxed) && take(t, i)) {
+            try {
+                fn(i, t);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(errorLock);
+                if (!error) error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) workers.emplace_back(worker, t);
+    for (std::thread& w : workers) w.join();
+    if (error) std::rethrow_exception(error);
+}
+
+// Sortowanie rownolegle: bloki sortowane niezaleznie, nastepnie scalane parami w kolejnych rundach
+template <typename It, typename Compare = std::less<>>
+void parallelSort(It first, It last, unsigned threads, Compare comp = {}) {
+    size_t n = static_cast<size_t>(last - first);
+    if (threads <= 1 || n < 4096) {
+        std::sort(first, last, comp);
+        return;
+    }
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(n / 1024));
+    std::vector<size_t> bounds(threads + 1);
+    for (unsigned t = 0; t <= threads; ++t) bounds[t] = n * t / threads;
+
+    parallelForBlocks(threads, threads, [&](size_t begin, size_t end, unsigned) {
+        for (size_t b = begin; b < end; ++b) std::sort(first + bounds[b], first + bounds[b + 1], comp);
+    });
+
+    for (size_t width = 1; width < threads; width *= 2) {
+        std::vector<std::thread> workers;
+        for (size_t b = 0; b + width < threads; b += 2 * width) {
+            size_t lo = bounds[b], mid = bounds[b + width], hi = bounds[std::min<size_t>(b + 2 * width, threads)];
+            workers.emplace_back([=] { std::inplace_merge(first + lo, first + mid, first + hi, comp); });
+        }
+        for (std::thread& w : workers) w.join();
+    }
+}
+
+#endif // PARALLEL_H
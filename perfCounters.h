@@ -0,0 +1,159 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <map>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define GRAPH_HAS_PERF_EVENTS 1
+#endif
+
+// Liczniki sprzetowe mierzone wokol wywolan algorytmow (tylko Linux, perf_event_open)
+constexpr size_t COUNTER_EVENTS = 5;
+
+inline const char* counterName(size_t i) {
+    static const char* const names[COUNTER_EVENTS] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+    return names[i];
+}
+
+using CounterValues = std::array<long long, COUNTER_EVENTS>;
+
+// Kazde zdarzenie otwierane osobno (bez grupy), zeby brak jednego nie wylaczal pozostalych;
+// inherit = 1 - do wyniku wliczane sa tez watki uruchomione przez algorytm (po ich zakonczeniu).
+// Liczniki dzialaja od otwarcia, read() zwraca wartosci narastajace przeskalowane o multipleksowanie.
+// Gdy jadro lub maszyna wirtualna ich nie udostepnia, available() == false i pomiary sa pomijane.
+class PerfCounters {
+public:
+    PerfCounters() {
+        fds.fill(-1);
+#ifdef GRAPH_HAS_PERF_EVENTS
+        const uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        const std::pair<uint32_t, uint64_t> events[COUNTER_EVENTS] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HW_CACHE, l1dReadMiss },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        };
+        for (size_t i = 0; i < COUNTER_EVENTS; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef GRAPH_HAS_PERF_EVENTS
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(size_t i) const { return fds[i] >= 0; }
+    bool available() const {
+        for (size_t i = 0; i < COUNTER_EVENTS; ++i)
+            if (available(i)) return true;
+        return false;
+    }
+
+    // Niedostepne zdarzenia maja wartosc 0 - o ich obecnosci decyduje available(i)
+    CounterValues read() const {
+        CounterValues values{};
+#ifdef GRAPH_HAS_PERF_EVENTS
+        for (size_t i = 0; i < COUNTER_EVENTS; ++i) {
+            uint64_t data[3];
+            if (fds[i] < 0 || ::read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+            values[i] = data[2] == 0 ? 0 : static_cast<long long>(static_cast<double>(data[0]) * data[1] / data[2]);
+        }
+#endif
+        return values;
+    }
+
+private:
+    std::array<int, COUNTER_EVENTS> fds;
+};
+
+// Suma czasu i licznikow jednej fazy algorytmu
+struct PhaseTotals {
+    long long ns = 0;
+    CounterValues counters{};
+};
+
+// Zbiera fazy zgloszone przez PhaseScope w watku, w ktorym jest aktywny. Bez aktywnego profilera
+// PhaseScope sprowadza sie do sprawdzenia wskaznika, wiec instrumentacja algorytmow nic nie kosztuje.
+class PhaseProfiler {
+public:
+    explicit PhaseProfiler(const PerfCounters* counters) : counters(counters) {}
+
+    static PhaseProfiler*& active() {
+        thread_local PhaseProfiler* current = nullptr;
+        return current;
+    }
+
+    CounterValues readCounters() const { return counters ? counters->read() : CounterValues{}; }
+
+    void add(const char* phase, long long ns, const CounterValues& begin, const CounterValues& end) {
+        PhaseTotals& totals = phases[phase];
+        totals.ns += ns;
+        for (size_t i = 0; i < COUNTER_EVENTS; ++i) totals.counters[i] += end[i] - begin[i];
+    }
+
+    // Fazy od ostatniego wywolania (jeden przebieg algorytmu)
+    std::map<std::string, PhaseTotals> take() {
+        std::map<std::string, PhaseTotals> result;
+        result.swap(phases);
+        return result;
+    }
+
+private:
+    const PerfCounters* counters;
+    std::map<std::string, PhaseTotals> phases;
+};
+
+// Oznacza faze algorytmu od konstrukcji do destrukcji; nazwa musi byc literalem
+class PhaseScope {
+public:
+    explicit PhaseScope(const char* name) : name(name), profiler(PhaseProfiler::active()) {
+        if (!profiler) return;
+        begin = profiler->readCounters();
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~PhaseScope() {
+        if (!profiler) return;
+        auto stop = std::chrono::steady_clock::now();
+        profiler->add(name, std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count(),
+            begin, profiler->readCounters());
+    }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    const char* name;
+    PhaseProfiler* profiler;
+    CounterValues begin{};
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,234 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <string>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "algorithms.h"
+
+// Przenumerowanie wierzcholkow poprawiajace lokalnosc: sasiedzi dostaja bliskie numery, wiec dist, key,
+// parent i wiersze CSR sasiadow leza blisko siebie w pamieci
+enum class VertexOrder {
+    NONE,
+    BFS,        // kolejnosc odwiedzin BFS (skladowe po kolei)
+    RCM,        // odwrocony Cuthill-McKee: BFS od wierzcholka o najmniejszym stopniu, sasiedzi rosnaco wg stopnia
+    DEGREE,     // malejaco wg stopnia - wierzcholki o wielu sasiadach razem na poczatku tablic
+    COMMUNITY   // spolecznosci z propagacji etykiet, kazda w ciaglym zakresie numerow
+};
+
+std::string vertexOrderName(VertexOrder order) {
+    switch (order) {
+    case VertexOrder::NONE: return "none";
+    case VertexOrder::BFS: return "bfs";
+    case VertexOrder::RCM: return "rcm";
+    case VertexOrder::DEGREE: return "degree";
+    case VertexOrder::COMMUNITY: return "community";
+    }
+    return "?";
+}
+
+// toNew[stary] = nowy, toOld[nowy] = stary
+struct VertexPermutation {
+    std::vector<int> toNew;
+    std::vector<int> toOld;
+
+    int newId(int v) const { return toNew[v]; }
+    int oldId(int v) const { return toOld[v]; }
+};
+
+// Sasiedzi bez wzgledu na kierunek lukow - dla grafu skierowanego rowniez luki wchodzace
+class SymmetricNeighbors {
+public:
+    explicit SymmetricNeighbors(const CSRGraph& g) : g(g) {
+        if (g.directed) reverse = g.reversed();
+    }
+
+    int degree(int u) const {
+        int d = g.offsets[u + 1] - g.offsets[u];
+        if (g.directed) d += reverse.offsets[u + 1] - reverse.offsets[u];
+        return d;
+    }
+
+    template <typename Fn>
+    void forEach(int u, Fn&& fn) const {
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) fn(g.targets[i]);
+        if (!g.directed) return;
+        for (int i = reverse.offsets[u]; i < reverse.offsets[u + 1]; ++i) fn(reverse.targets[i]);
+    }
+
+private:
+    const CSRGraph& g;
+    CSRGraph reverse;
+};
+
+VertexPermutation permutationFromOrder(std::vector<int> order) {
+    VertexPermutation perm;
+    perm.toNew.assign(order.size(), -1);
+    for (size_t i = 0; i < order.size(); ++i) perm.toNew[order[i]] = static_cast<int>(i);
+    perm.toOld = std::move(order);
+    return perm;
+}
+
+// BFS po kolejnych skladowych; startFor wybiera pierwszy wierzcholek skladowej sposrod nieodwiedzonych,
+// sortNeighbors porzadkuje sasiadow dolaczanych do kolejki z jednego wierzcholka
+template <typename Start, typename Sort>
+std::vector<int> breadthFirstOrder(const SymmetricNeighbors& nb, int n, Start&& startFor, Sort&& sortNeighbors) {
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> visited(n, 0);
+    for (int next = 0; static_cast<int>(order.size()) < n;) {
+        while (visited[next]) ++next;
+        int start = startFor(next, visited);
+        visited[start] = 1;
+        size_t head = order.size();
+        order.push_back(start);
+        while (head < order.size()) {
+            int u = order[head++];
+            size_t first = order.size();
+            nb.forEach(u, [&](int v) {
+                if (visited[v]) return;
+                visited[v] = 1;
+                order.push_back(v);
+            });
+            sortNeighbors(order.begin() + first, order.end());
+        }
+    }
+    return order;
+}
+
+// Propagacja etykiet: kazdy wierzcholek przejmuje najczestsza etykiete sasiadow (remis - mniejsza),
+// az do braku zmian lub maxRounds rund. Uproszczona wersja grupowania z Rabbit Order.
+std::vector<int> labelPropagation(const SymmetricNeighbors& nb, int n, int maxRounds = 10) {
+    std::vector<int> label(n);
+    std::iota(label.begin(), label.end(), 0);
+    std::vector<int> count(n, 0);
+    std::vector<int> seen;
+    for (int round = 0; round < maxRounds; ++round) {
+        bool changed = false;
+        for (int u = 0; u < n; ++u) {
+            seen.clear();
+            nb.forEach(u, [&](int v) {
+                if (count[label[v]]++ == 0) seen.push_back(label[v]);
+            });
+            int best = label[u];
+            int bestCount = 0;
+            for (int l : seen) {
+                if (count[l] > bestCount || (count[l] == bestCount && l < best)) {
+                    best = l;
+                    bestCount = count[l];
+                }
+                count[l] = 0;
+            }
+            if (best != label[u]) {
+                label[u] = best;
+                changed = true;
+            }
+        }
+        if (!changed) break;
+    }
+    return label;
+}
+
+VertexPermutation computeVertexOrder(const CSRGraph& g, VertexOrder order) {
+    const int n = g.vertices;
+    if (order == VertexOrder::NONE) {
+        std::vector<int> identity(n);
+        std::iota(identity.begin(), identity.end(), 0);
+        return permutationFromOrder(std::move(identity));
+    }
+    SymmetricNeighbors nb(g);
+    auto firstUnvisited = [](int next, const std::vector<char>&) { return next; };
+    auto keepOrder = [](auto, auto) {};
+
+    if (order == VertexOrder::BFS) return permutationFromOrder(breadthFirstOrder(nb, n, firstUnvisited, keepOrder));
+
+    if (order == VertexOrder::DEGREE) {
+        std::vector<int> byDegree(n);
+        std::iota(byDegree.begin(), byDegree.end(), 0);
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return nb.degree(a) > nb.degree(b); });
+        return permutationFromOrder(std::move(byDegree));
+    }
+
+    if (order == VertexOrder::RCM) {
+        // Wierzcholki rosnaco wg stopnia - pierwszy nieodwiedzony to start skladowej o najmniejszym stopniu
+        std::vector<int> byDegree(n);
+        std::iota(byDegree.begin(), byDegree.end(), 0);
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return nb.degree(a) < nb.degree(b); });
+        size_t cursor = 0;
+        auto minDegreeStart = [&](int, const std::vector<char>& visited) {
+            while (visited[byDegree[cursor]]) ++cursor;
+            return byDegree[cursor];
+        };
+        auto byDegreeAsc = [&](std::vector<int>::iterator first, std::vector<int>::iterator last) {
+            std::stable_sort(first, last, [&](int a, int b) { return nb.degree(a) < nb.degree(b); });
+        };
+        std::vector<int> cm = breadthFirstOrder(nb, n, minDegreeStart, byDegreeAsc);
+        std::reverse(cm.begin(), cm.end());
+        return permutationFromOrder(std::move(cm));
+    }
+
+    // COMMUNITY: spolecznosci w kolejnosci pierwszego wystapienia w BFS, wewnatrz - kolejnosc BFS
+    std::vector<int> label = labelPropagation(nb, n);
+    std::vector<int> bfs = breadthFirstOrder(nb, n, firstUnvisited, keepOrder);
+    std::vector<int> position(n), rank(n, -1);
+    int communities = 0;
+    for (int i = 0; i < n; ++i) {
+        position[bfs[i]] = i;
+        if (rank[label[bfs[i]]] == -1) rank[label[bfs[i]]] = communities++;
+    }
+    std::vector<int> start(communities + 1, 0);
+    for (int v = 0; v < n; ++v) ++start[rank[label[v]] + 1];
+    for (int c = 0; c < communities; ++c) start[c + 1] += start[c];
+    std::vector<int> grouped(n);
+    for (int v : bfs) grouped[start[rank[label[v]]]++] = v;
+    return permutationFromOrder(std::move(grouped));
+}
+
+// Krawedzie z numerami po przenumerowaniu (kolejnosc listy bez zmian)
+std::vector<Edge> relabelEdges(std::span<const Edge> edges, const VertexPermutation& perm) {
+    std::vector<Edge> result(edges.begin(), edges.end());
+    for (Edge& e : result) {
+        e.from = perm.toNew[e.from];
+        e.to = perm.toNew[e.to];
+    }
+    return result;
+}
+
+Graph reorderGraph(const Graph& g, const VertexPermutation& perm) {
+    Graph result(g.vertices, g.directed, g.representation);
+    result.setEdges(relabelEdges(g.edges, perm));
+    return result;
+}
+
+CSRGraph reorderCSR(const CSRGraph& g, const VertexPermutation& perm) {
+    std::vector<Edge> edges = relabelEdges(edgeList(g), perm);
+    return CSRGraph(g.vertices, g.directed, edges);
+}
+
+// Wyniki z powrotem w numeracji wejsciowej
+void restoreEdges(std::vector<Edge>& edges, const VertexPermutation& perm) {
+    for (Edge& e : edges) {
+        e.from = perm.toOld[e.from];
+        e.to = perm.toOld[e.to];
+    }
+}
+
+// values[nowy] -> wynik[stary], np. dist
+template <typename T>
+std::vector<T> restoreVertexValues(const std::vector<T>& values, const VertexPermutation& perm) {
+    std::vector<T> result(values.size());
+    for (size_t v = 0; v < values.size(); ++v) result[perm.toOld[v]] = values[v];
+    return result;
+}
+
+// Jak restoreVertexValues, ale wartosci tez sa wierzcholkami (prev, -1 bez zmian)
+std::vector<int> restorePredecessors(const std::vector<int>& prev, const VertexPermutation& perm) {
+    std::vector<int> result(prev.size());
+    for (size_t v = 0; v < prev.size(); ++v) result[perm.toOld[v]] = prev[v] == -1 ? -1 : perm.toOld[prev[v]];
+    return result;
+}
+
+#endif // REORDER_H
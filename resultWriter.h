@@ -0,0 +1,307 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <ostream>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include "algorithms.h"
+#include "snapshot.h"
+
+// Zapis przez staly bufor (domyslnie 1 MiB) do strumienia. Liczby calkowite zamieniane sa na tekst przez
+// std::to_chars - bez locale i stanu formatowania strumienia. Dane binarne dopisywane sa tym samym buforem;
+// position() to liczba bajtow od poczatku zapisu (do wyrownania sekcji). Blad zapisu - wyjatek przy flush().
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::ostream& sink, size_t capacity = size_t(1) << 20)
+        : sink(sink), buffer(std::max<size_t>(capacity, 64)) {}
+
+    // Destruktor nie zglasza bledow - wywolaj flush(), zeby je wykryc
+    ~BufferedWriter() {
+        try {
+            flush();
+        }
+        catch (...) {
+        }
+    }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    BufferedWriter& write(const void* data, size_t bytes) {
+        if (bytes > buffer.size() - used) {
+            drain();
+            if (bytes >= buffer.size()) {
+                sink.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+                written += bytes;
+                return *this;
+            }
+        }
+        std::memcpy(buffer.data() + used, data, bytes);
+        used += bytes;
+        return *this;
+    }
+
+    BufferedWriter& operator<<(std::string_view s) { return write(s.data(), s.size()); }
+    BufferedWriter& operator<<(const char* s) { return *this << std::string_view(s); }
+    BufferedWriter& operator<<(const std::string& s) { return *this << std::string_view(s); }
+
+    BufferedWriter& operator<<(char c) {
+        if (used == buffer.size()) drain();
+        buffer[used++] = c;
+        return *this;
+    }
+
+    template <typename T>
+        requires (std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>)
+    BufferedWriter& operator<<(T value) {
+        if (buffer.size() - used < 24) drain();
+        std::to_chars_result r = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+        used = static_cast<size_t>(r.ptr - buffer.data());
+        return *this;
+    }
+
+    // Zera do najblizszej wielokrotnosci alignment
+    void pad(size_t alignment) {
+        static const char zeros[SNAPSHOT_ALIGN] = {};
+        size_t gap = (alignment - position() % alignment) % alignment;
+        while (gap > 0) {
+            size_t n = std::min(gap, sizeof(zeros));
+            write(zeros, n);
+            gap -= n;
+        }
+    }
+
+    size_t position() const { return written + used; }
+
+    void flush() {
+        drain();
+        sink.flush();
+        if (!sink) throw std::runtime_error("Cannot write output file");
+    }
+
+private:
+    void drain() {
+        if (used == 0) return;
+        sink.write(buffer.data(), static_cast<std::streamsize>(used));
+        written += used;
+        used = 0;
+    }
+
+    std::ostream& sink;
+    std::vector<char> buffer;
+    size_t used = 0;
+    size_t written = 0;
+};
+
+enum class ResultFormat { TEXT, BINARY };
+
+// Binarny plik wyniku (wersja 1), porzadek bajtow maszyny jak w snapshot.h:
+//   naglowek ResultHeader (64 B), sekcje od granic 64 B
+//   MST:      edges: count x {from, to, weight}
+//   sciezki:  dist: count x int64 (INT64_MAX - nieosiagalny)   prev: count x int32   cycle: extra x int32
+//   przeplyw: cut: count x {from, to, weight}   sourceSide: extra x uint8
+// Sekcje mozna mapowac bezposrednio jako tablice (ResultView).
+constexpr char RESULT_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'R', 'E', 'S' };
+constexpr uint32_t RESULT_VERSION = 1;
+
+enum class ResultKind : uint32_t { MST = 1, SHORTEST_PATHS = 2, MAX_FLOW = 3 };
+
+struct ResultHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t kind;
+    uint32_t reserved;
+    uint64_t count;     // MST: krawedzie, sciezki: wierzcholki, przeplyw: krawedzie przekroju
+    uint64_t extra;     // sciezki: dlugosc ujemnego cyklu (0 - brak), przeplyw: wierzcholki w sourceSide
+    int64_t value;      // MST: waga, sciezki: start, przeplyw: wartosc przeplywu
+    int64_t target;     // sciezki: end
+    uint64_t padding;
+};
+
+static_assert(sizeof(ResultHeader) == SNAPSHOT_ALIGN, "Result header must fill one aligned block");
+
+// Polozenie sekcji wyliczane wylacznie z naglowka
+struct ResultLayout {
+    size_t first = 0, second = 0, third = 0, end = 0;
+
+    explicit ResultLayout(const ResultHeader& h) {
+        auto align = [](size_t x) { return (x + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN; };
+        first = sizeof(ResultHeader);
+        switch (static_cast<ResultKind>(h.kind)) {
+        case ResultKind::MST:
+            end = second = third = first + h.count * sizeof(Edge);
+            break;
+        case ResultKind::SHORTEST_PATHS:
+            second = align(first + h.count * sizeof(int64_t));
+            third = align(second + h.count * sizeof(int32_t));
+            end = third + h.extra * sizeof(int32_t);
+            break;
+        case ResultKind::MAX_FLOW:
+            second = align(first + h.count * sizeof(Edge));
+            end = third = second + h.extra;
+            break;
+        }
+    }
+};
+
+inline ResultHeader resultHeader(ResultKind kind) {
+    ResultHeader header{};
+    std::memcpy(header.magic, RESULT_MAGIC, sizeof(RESULT_MAGIC));
+    header.version = RESULT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.kind = static_cast<uint32_t>(kind);
+    return header;
+}
+
+// Drzewo rozpinajace: tekst "MST (algorytm):", waga i krawedzie albo plik binarny
+inline void writeMSTResult(BufferedWriter& out, ResultFormat format, const char* algorithm, const std::vector<Edge>& mst) {
+    long long weight = 0;
+    for (const Edge& edge : mst) weight += edge.weight;
+    if (format == ResultFormat::BINARY) {
+        ResultHeader header = resultHeader(ResultKind::MST);
+        header.count = mst.size();
+        header.value = weight;
+        out.write(&header, sizeof(header));
+        out.write(mst.data(), mst.size() * sizeof(Edge));
+        return;
+    }
+    out << "MST (" << algorithm << "):\n";
+    out << "Total weight: " << weight << "\n";
+    for (const Edge& edge : mst) out << edge.from << ' ' << edge.to << ' ' << edge.weight << '\n';
+}
+
+// Pelne tablice dist/prev i ewentualny ujemny cykl; Dist - int albo long long (max - nieosiagalny)
+template <typename Dist>
+void writePathsBinary(BufferedWriter& out, int start, int end, const std::vector<Dist>& dist, const std::vector<int>& prev,
+    const std::vector<int>& cycle) {
+    ResultHeader header = resultHeader(ResultKind::SHORTEST_PATHS);
+    header.count = prev.size();
+    header.extra = cycle.size();
+    header.value = start;
+    header.target = end;
+    out.write(&header, sizeof(header));
+    for (size_t v = 0; v < prev.size(); ++v) {
+        int64_t d = v < dist.size() && dist[v] != std::numeric_limits<Dist>::max()
+            ? static_cast<int64_t>(dist[v]) : std::numeric_limits<int64_t>::max();
+        out.write(&d, sizeof(d));
+    }
+    out.pad(SNAPSHOT_ALIGN);
+    out.write(prev.data(), prev.size() * sizeof(int));
+    out.pad(SNAPSHOT_ALIGN);
+    out.write(cycle.data(), cycle.size() * sizeof(int));
+}
+
+// Przeplyw; withCut == false (Ford-Fulkerson) - tylko wartosc, bez sekcji przekroju
+inline void writeFlowResult(BufferedWriter& out, ResultFormat format, const MaxFlowResult& flow, bool withCut) {
+    if (format == ResultFormat::BINARY) {
+        ResultHeader header = resultHeader(ResultKind::MAX_FLOW);
+        header.count = withCut ? flow.cutEdges.size() : 0;
+        header.extra = withCut ? flow.sourceSide.size() : 0;
+        header.value = flow.flow;
+        out.write(&header, sizeof(header));
+        if (!withCut) return;
+        out.write(flow.cutEdges.data(), flow.cutEdges.size() * sizeof(Edge));
+        out.pad(SNAPSHOT_ALIGN);
+        out.write(flow.sourceSide.data(), flow.sourceSide.size());
+        return;
+    }
+    out << "Maksymalny przeplyw: " << flow.flow << "\n";
+    if (!withCut) return;
+    out << "Przekroj minimalny (" << flow.cutEdges.size() << " krawedzi):\n";
+    for (const Edge& edge : flow.cutEdges) out << edge.from << ' ' << edge.to << ' ' << edge.weight << '\n';
+}
+
+// Binarny plik wyniku zmapowany tylko do odczytu; przy otwarciu sprawdzany jest naglowek i rozmiar
+class ResultView {
+public:
+    explicit ResultView(const std::string& filename) : file(filename) {
+        if (file.size() < sizeof(ResultHeader)) throw std::runtime_error("Result file too short");
+        std::memcpy(&head, file.data(), sizeof(head));
+        if (std::memcmp(head.magic, RESULT_MAGIC, sizeof(RESULT_MAGIC)) != 0) throw std::runtime_error("Not a binary result file");
+        if (head.byteOrder != SNAPSHOT_BYTE_ORDER) throw std::runtime_error("Result written with a different byte order");
+        if (head.version != RESULT_VERSION) throw std::runtime_error("Unsupported result version " + std::to_string(head.version));
+        if (head.kind < static_cast<uint32_t>(ResultKind::MST) || head.kind > static_cast<uint32_t>(ResultKind::MAX_FLOW))
+            throw std::runtime_error("Unknown result kind");
+        // count i extra ograniczone rozmiarem pliku, zanim trafia do mnozen w ResultLayout
+        if (head.count > file.size() / sizeof(int32_t) || head.extra > file.size() || file.size() < ResultLayout(head).end) throw std::runtime_error("Result file truncated");
+    }
+
+    const ResultHeader& header() const { return head; }
+    ResultKind kind() const { return static_cast<ResultKind>(head.kind); }
+
+    // MST albo krawedzie przekroju
+    std::span<const Edge> edges() const {
+        if (kind() == ResultKind::SHORTEST_PATHS) return {};
+        return section<Edge>(ResultLayout(head).first, head.count);
+    }
+    std::span<const int64_t> dist() const { return paths<int64_t>(ResultLayout(head).first, head.count); }
+    std::span<const int32_t> prev() const { return paths<int32_t>(ResultLayout(head).second, head.count); }
+    std::span<const int32_t> cycle() const { return paths<int32_t>(ResultLayout(head).third, head.extra); }
+    std::span<const uint8_t> sourceSide() const {
+        if (kind() != ResultKind::MAX_FLOW) return {};
+        return section<uint8_t>(ResultLayout(head).second, head.extra);
+    }
+
+private:
+    template <typename T>
+    std::span<const T> section(size_t offset, uint64_t count) const {
+        return { reinterpret_cast<const T*>(file.data() + offset), static_cast<size_t>(count) };
+    }
+
+    template <typename T>
+    std::span<const T> paths(size_t offset, uint64_t count) const {
+        if (kind() != ResultKind::SHORTEST_PATHS) return {};
+        return section<T>(offset, count);
+    }
+
+    MappedFile file;
+    ResultHeader head;
+};
+
+// Porownanie pliku odczytanego przez ResultView z wynikiem w pamieci - sprawdzenie zapisu (--verify)
+inline bool sameEdges(std::span<const Edge> stored, const std::vector<Edge>& edges) {
+    return std::equal(stored.begin(), stored.end(), edges.begin(), edges.end(),
+        [](const Edge& a, const Edge& b) { return a.from == b.from && a.to == b.to && a.weight == b.weight; });
+}
+
+inline bool resultMatches(const ResultView& view, const std::vector<Edge>& mst) {
+    long long weight = 0;
+    for (const Edge& edge : mst) weight += edge.weight;
+    return view.kind() == ResultKind::MST && view.header().value == weight && sameEdges(view.edges(), mst);
+}
+
+template <typename Dist>
+bool resultMatches(const ResultView& view, int start, int end, const std::vector<Dist>& dist, const std::vector<int>& prev,
+    const std::vector<int>& cycle) {
+    if (view.kind() != ResultKind::SHORTEST_PATHS || view.header().value != start || view.header().target != end) return false;
+    std::span<const int64_t> storedDist = view.dist();
+    if (storedDist.size() != prev.size()) return false;
+    for (size_t v = 0; v < prev.size(); ++v) {
+        int64_t d = v < dist.size() && dist[v] != std::numeric_limits<Dist>::max()
+            ? static_cast<int64_t>(dist[v]) : std::numeric_limits<int64_t>::max();
+        if (storedDist[v] != d) return false;
+    }
+    std::span<const int32_t> storedPrev = view.prev(), storedCycle = view.cycle();
+    return std::equal(storedPrev.begin(), storedPrev.end(), prev.begin(), prev.end())
+        && std::equal(storedCycle.begin(), storedCycle.end(), cycle.begin(), cycle.end());
+}
+
+inline bool resultMatches(const ResultView& view, const MaxFlowResult& flow, bool withCut) {
+    if (view.kind() != ResultKind::MAX_FLOW || view.header().value != flow.flow) return false;
+    if (!withCut) return view.header().count == 0 && view.header().extra == 0;
+    std::span<const uint8_t> side = view.sourceSide();
+    return sameEdges(view.edges(), flow.cutEdges) && std::equal(side.begin(), side.end(), flow.sourceSide.begin(),
+        flow.sourceSide.end(), [](uint8_t a, char b) { return a == static_cast<uint8_t>(b); });
+}
+
+#endif // RESULT_WRITER_H
@@ -0,0 +1,264 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define GRAPH_HAS_X86_SIMD 1
+#define GRAPH_TARGET_AVX2 __attribute__((target("avx2")))
+#define GRAPH_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl")))
+#endif
+
+// Jadra petli gestych (macierz sasiedztwa i tablice V-elementowe) w wersjach skalarnej, AVX2 i AVX-512.
+// Wersja wybierana w czasie dzialania wg CPU (lub --simd); kod kompilowany jest bez -mavx2, kazda funkcja
+// wektorowa ma wlasny atrybut target. Wyniki sa identyczne z wersja skalarna (te same remisy i kolejnosc).
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+std::string simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::SCALAR: return "scalar";
+    case SimdLevel::AVX2: return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    }
+    return "?";
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef GRAPH_HAS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+        return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+// ---- wersje skalarne (wzorzec zachowania dla wektorowych) ----
+
+// Pierwszy indeks o najmniejszym key wsrod nieoznaczonych (marked[i] == 0); -1, gdy wszystkie oznaczone
+int argMinUnmarkedScalar(const int* key, const char* marked, int n) {
+    int best = -1;
+    for (int i = 0; i < n; ++i)
+        if (!marked[i] && (best == -1 || key[i] < key[best])) best = i;
+    return best;
+}
+
+// Relaksacja wiersza u macierzy sasiedztwa: dla kazdego ustawionego bitu v, gdy du + w[v] < dist[v],
+// dist[v] = du + w[v] i prev[v] = u. Zwraca true, gdy cos sie zmienilo. Wiersz nie moze miec ujemnej
+// petli w u (wtedy du zmienialoby sie w trakcie wiersza - wywolujacy obsluguje ten przypadek sam).
+bool relaxMatrixRowScalar(int u, int du, const uint64_t* bits, const int* weights, int n, int* dist, int* prev) {
+    bool changed = false;
+    for (int wi = 0; wi * 64 < n; ++wi) {
+        for (uint64_t word = bits[wi]; word; word &= word - 1) {
+            int v = wi * 64 + std::countr_zero(word);
+            if (du + weights[v] < dist[v]) {
+                dist[v] = du + weights[v];
+                prev[v] = u;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+// Pierwszy indeks >= from z values[i] > 0; n, gdy brak
+int nextPositiveScalar(const int* values, int from, int n) {
+    for (int i = from; i < n; ++i)
+        if (values[i] > 0) return i;
+    return n;
+}
+
+#ifdef GRAPH_HAS_X86_SIMD
+// ---- AVX2: 8 liczb int na rejestr ----
+
+GRAPH_TARGET_AVX2 int argMinUnmarkedAvx2(const int* key, const char* marked, int n) {
+    const __m256i inf = _mm256_set1_epi32(INT_MAX);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i best = inf;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i open = _mm256_cmpeq_epi32(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(marked + i))), zero);
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + i));
+        best = _mm256_min_epi32(best, _mm256_blendv_epi8(inf, k, open));
+    }
+    __m128i b = _mm_min_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    b = _mm_min_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2)));
+    b = _mm_min_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1)));
+    int minKey = _mm_cvtsi128_si32(b);
+    for (int j = i; j < n; ++j)
+        if (!marked[j]) minKey = std::min(minKey, key[j]);
+    // minimum INT_MAX: nieoznaczone moga miec klucz INT_MAX albo ich nie ma - jak w wersji skalarnej
+    // wygrywa pierwszy nieoznaczony
+    if (minKey == INT_MAX) {
+        const char* first = std::find(marked, marked + n, 0);
+        return first == marked + n ? -1 : static_cast<int>(first - marked);
+    }
+    const __m256i target = _mm256_set1_epi32(minKey);
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i open = _mm256_cmpeq_epi32(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(marked + i))), zero);
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + i));
+        __m256i hit = _mm256_and_si256(open, _mm256_cmpeq_epi32(k, target));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(hit));
+        if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+    }
+    for (; i < n; ++i)
+        if (!marked[i] && key[i] == minKey) return i;
+    return -1;
+}
+
+// 8 bitow wiersza -> maska 8 pasow int
+GRAPH_TARGET_AVX2 inline __m256i laneMaskAvx2(unsigned bits8) {
+    const __m256i select = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits8)), select), select);
+}
+
+GRAPH_TARGET_AVX2 bool relaxMatrixRowAvx2(int u, int du, const uint64_t* bits, const int* weights, int n, int* dist, int* prev) {
+    const __m256i base = _mm256_set1_epi32(du);
+    const __m256i from = _mm256_set1_epi32(u);
+    bool changed = false;
+    for (int wi = 0; wi * 64 < n; ++wi) {
+        uint64_t word = bits[wi];
+        if (!word) continue;
+        int c = wi * 64;
+        const int end = std::min(n, c + 64);
+        for (; c + 8 <= end; c += 8, word >>= 8) {
+            if (!(word & 0xFF)) continue;
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dist + c));
+            __m256i cand = _mm256_add_epi32(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + c)));
+            __m256i better = _mm256_and_si256(_mm256_cmpgt_epi32(d, cand), laneMaskAvx2(static_cast<unsigned>(word & 0xFF)));
+            if (_mm256_testz_si256(better, better)) continue;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dist + c), _mm256_blendv_epi8(d, cand, better));
+            __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + c));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(prev + c), _mm256_blendv_epi8(p, from, better));
+            changed = true;
+        }
+        // koncowka wiersza krotsza niz 8 kolumn
+        for (; word && c < end; ++c, word >>= 1) {
+            if ((word & 1) && du + weights[c] < dist[c]) {
+                dist[c] = du + weights[c];
+                prev[c] = u;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+GRAPH_TARGET_AVX2 int nextPositiveAvx2(const int* values, int from, int n) {
+    const __m256i zero = _mm256_setzero_si256();
+    int i = from;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, zero)));
+        if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+    }
+    return nextPositiveScalar(values, i, n);
+}
+
+// ---- AVX-512: 16 liczb int, maski w rejestrach k; ladowania z maska nie siegaja poza tablice ----
+
+GRAPH_TARGET_AVX512 int argMinUnmarkedAvx512(const int* key, const char* marked, int n) {
+    const __m512i inf = _mm512_set1_epi32(INT_MAX);
+    __m512i best = inf;
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 valid = n - i >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        __m512i m = _mm512_maskz_cvtepi8_epi32(valid, _mm_maskz_loadu_epi8(valid, marked + i));
+        __mmask16 open = _mm512_mask_cmpeq_epi32_mask(valid, m, _mm512_setzero_si512());
+        best = _mm512_mask_min_epi32(best, open, best, _mm512_maskz_loadu_epi32(open, key + i));
+    }
+    // redukcja przez polowki (warianty maskz - bez niezainicjowanych rejestrow w naglowkach GCC)
+    __m256i half = _mm256_min_epi32(_mm512_maskz_extracti64x4_epi64(0xFF, best, 0), _mm512_maskz_extracti64x4_epi64(0xFF, best, 1));
+    __m128i b = _mm_min_epi32(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+    b = _mm_min_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2)));
+    b = _mm_min_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1)));
+    int minKey = _mm_cvtsi128_si32(b);
+    if (minKey == INT_MAX) {
+        const char* first = std::find(marked, marked + n, 0);
+        return first == marked + n ? -1 : static_cast<int>(first - marked);
+    }
+    const __m512i target = _mm512_set1_epi32(minKey);
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 valid = n - i >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        __m512i m = _mm512_maskz_cvtepi8_epi32(valid, _mm_maskz_loadu_epi8(valid, marked + i));
+        __mmask16 open = _mm512_mask_cmpeq_epi32_mask(valid, m, _mm512_setzero_si512());
+        __mmask16 hit = _mm512_mask_cmpeq_epi32_mask(open, _mm512_maskz_loadu_epi32(open, key + i), target);
+        if (hit) return i + std::countr_zero(static_cast<unsigned>(hit));
+    }
+    return -1;
+}
+
+GRAPH_TARGET_AVX512 bool relaxMatrixRowAvx512(int u, int du, const uint64_t* bits, const int* weights, int n, int* dist, int* prev) {
+    const __m512i base = _mm512_set1_epi32(du);
+    const __m512i from = _mm512_set1_epi32(u);
+    bool changed = false;
+    for (int wi = 0; wi * 64 < n; ++wi) {
+        uint64_t word = bits[wi];
+        for (int c = wi * 64; word; c += 16, word >>= 16) {
+            __mmask16 lanes = static_cast<__mmask16>(word & 0xFFFF);
+            if (!lanes) continue;
+            __m512i d = _mm512_maskz_loadu_epi32(lanes, dist + c);
+            __m512i cand = _mm512_add_epi32(base, _mm512_maskz_loadu_epi32(lanes, weights + c));
+            __mmask16 better = _mm512_mask_cmpgt_epi32_mask(lanes, d, cand);
+            if (!better) continue;
+            _mm512_mask_storeu_epi32(dist + c, better, cand);
+            _mm512_mask_storeu_epi32(prev + c, better, from);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+GRAPH_TARGET_AVX512 int nextPositiveAvx512(const int* values, int from, int n) {
+    const __m512i zero = _mm512_setzero_si512();
+    for (int i = from; i < n; i += 16) {
+        __mmask16 valid = n - i >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        __mmask16 hit = _mm512_mask_cmpgt_epi32_mask(valid, _mm512_maskz_loadu_epi32(valid, values + i), zero);
+        if (hit) return i + std::countr_zero(static_cast<unsigned>(hit));
+    }
+    return n;
+}
+#endif
+
+// Zestaw jader jednego poziomu; wskazniki wybierane raz, wywolanie kosztuje jeden skok posredni
+struct SimdKernels {
+    SimdLevel level;
+    int (*argMinUnmarked)(const int* key, const char* marked, int n);
+    bool (*relaxMatrixRow)(int u, int du, const uint64_t* bits, const int* weights, int n, int* dist, int* prev);
+    int (*nextPositive)(const int* values, int from, int n);
+};
+
+const SimdKernels& simdKernels(SimdLevel level) {
+    static const SimdKernels scalar{ SimdLevel::SCALAR, argMinUnmarkedScalar, relaxMatrixRowScalar, nextPositiveScalar };
+#ifdef GRAPH_HAS_X86_SIMD
+    static const SimdKernels avx2{ SimdLevel::AVX2, argMinUnmarkedAvx2, relaxMatrixRowAvx2, nextPositiveAvx2 };
+    static const SimdKernels avx512{ SimdLevel::AVX512, argMinUnmarkedAvx512, relaxMatrixRowAvx512, nextPositiveAvx512 };
+    if (level == SimdLevel::AVX512) return avx512;
+    if (level == SimdLevel::AVX2) return avx2;
+#endif
+    return scalar;
+}
+
+// Biezacy zestaw (domyslnie najlepszy dostepny na tym CPU); zmieniany tylko przed uruchomieniem algorytmow
+const SimdKernels*& activeSimdKernels() {
+    static const SimdKernels* active = &simdKernels(detectSimdLevel());
+    return active;
+}
+
+const SimdKernels& simd() {
+    return *activeSimdKernels();
+}
+
+void setSimdLevel(SimdLevel level) {
+    if (level > detectSimdLevel())
+        throw std::invalid_argument("SIMD level not supported by this CPU: " + simdLevelName(level));
+    activeSimdKernels() = &simdKernels(level);
+}
+
+#endif // SIMD_H
@@ -0,0 +1,199 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <span>
+#include <memory>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "algorithms.h"
+#include "loader.h"
+
+// Binarny snapshot grafu (wersja 1). Uklad pliku, wszystkie liczby w porzadku bajtow maszyny:
+//   naglowek SnapshotHeader (64 B)
+//   offsets: (V + 1) x int32   targets: A x int32   weights: A x int32   edges: E x {from, to, weight}
+// Kazda sekcja zaczyna sie na granicy 64 B. CSR zapisany jest dla skierowania podanego przy konwersji,
+// lista krawedzi w kolejnosci z pliku tekstowego. Suma kontrolna obejmuje wszystkie sekcje.
+
+constexpr char SNAPSHOT_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P' };
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+constexpr uint32_t SNAPSHOT_DIRECTED = 1;
+constexpr size_t SNAPSHOT_ALIGN = 64;
+
+static_assert(sizeof(Edge) == 3 * sizeof(int32_t), "Edge must be three packed int32 values");
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t arcs;
+    uint64_t checksum;
+    uint64_t padding;
+};
+
+static_assert(sizeof(SnapshotHeader) == SNAPSHOT_ALIGN, "Snapshot header must fill one aligned block");
+
+// Polozenie sekcji wyliczane wylacznie z licznikow w naglowku
+struct SnapshotLayout {
+    size_t offsets, targets, weights, edges, end;
+
+    explicit SnapshotLayout(const SnapshotHeader& h) {
+        auto align = [](size_t x) { return (x + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN; };
+        offsets = sizeof(SnapshotHeader);
+        targets = align(offsets + (h.vertices + 1) * sizeof(int32_t));
+        weights = align(targets + h.arcs * sizeof(int32_t));
+        edges = align(weights + h.arcs * sizeof(int32_t));
+        end = edges + h.edges * sizeof(Edge);
+    }
+};
+
+// Suma kontrolna liczona slowami 64-bitowymi; kolejne sekcje dopisywane do tego samego stanu
+inline uint64_t snapshotChecksum(uint64_t state, const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        state = (std::rotl(state ^ (word * 0x9E3779B97F4A7C15ull), 27)) * 0x100000001B3ull;
+    }
+    for (; i < bytes; ++i) state = (state ^ p[i]) * 0x100000001B3ull;
+    return state;
+}
+
+constexpr uint64_t SNAPSHOT_CHECKSUM_SEED = 0xCBF29CE484222325ull;
+
+inline bool isGraphSnapshot(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
+
+// Zapisuje graf jako snapshot; CSR budowany jest dla g.directed
+void writeGraphSnapshot(const std::string& filename, const Graph& g) {
+    CSRGraph csr(g);
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.flags = g.directed ? SNAPSHOT_DIRECTED : 0;
+    header.vertices = static_cast<uint64_t>(g.vertices);
+    header.edges = g.edges.size();
+    header.arcs = static_cast<uint64_t>(csr.arcCount());
+
+    struct Section { size_t at; const void* data; size_t bytes; };
+    SnapshotLayout layout(header);
+    const Section sections[] = {
+        { layout.offsets, csr.offsets.data(), csr.offsets.size_bytes() },
+        { layout.targets, csr.targets.data(), csr.targets.size_bytes() },
+        { layout.weights, csr.weights.data(), csr.weights.size_bytes() },
+        { layout.edges, g.edges.data(), g.edges.size() * sizeof(Edge) },
+    };
+    header.checksum = SNAPSHOT_CHECKSUM_SEED;
+    for (const Section& s : sections) header.checksum = snapshotChecksum(header.checksum, s.data, s.bytes);
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot open snapshot file for writing");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    size_t written = sizeof(header);
+    const char zeros[SNAPSHOT_ALIGN] = {};
+    for (const Section& s : sections) {
+        out.write(zeros, static_cast<std::streamsize>(s.at - written));
+        out.write(static_cast<const char*>(s.data), static_cast<std::streamsize>(s.bytes));
+        written = s.at + s.bytes;
+    }
+    if (!out) throw std::runtime_error("Error while writing snapshot file");
+}
+
+// Snapshot zmapowany tylko do odczytu. Przy otwarciu sprawdzany jest naglowek, rozmiary sekcji
+// i monotonicznosc offsets (O(V)); numery wierzcholkow w targets i liscie krawedzi - przed pierwszym
+// uzyciem, pelna suma kontrolna - dopiero w verify().
+class GraphSnapshot {
+public:
+    explicit GraphSnapshot(const std::string& filename) : file(std::make_shared<MappedFile>(filename)) {
+        if (file->size() < sizeof(SnapshotHeader)) throw std::runtime_error("Snapshot file too short");
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+            throw std::runtime_error("Not a graph snapshot file");
+        if (header.byteOrder != SNAPSHOT_BYTE_ORDER)
+            throw std::runtime_error("Snapshot written with a different byte order");
+        if (header.version != SNAPSHOT_VERSION)
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version));
+        if (header.vertices > static_cast<uint64_t>(std::numeric_limits<int>::max())
+            || header.arcs > static_cast<uint64_t>(std::numeric_limits<int>::max())
+            || header.edges > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+            throw std::runtime_error("Snapshot too large for 32-bit vertex, arc and edge indices");
+        SnapshotLayout layout(header);
+        if (file->size() < layout.end) throw std::runtime_error("Snapshot file truncated");
+        std::span<const int> offs = offsets();
+        if (offs.front() != 0 || offs.back() != static_cast<int>(header.arcs))
+            throw std::runtime_error("Corrupted snapshot: arc count mismatch");
+        for (size_t v = 1; v < offs.size(); ++v)
+            if (offs[v] < offs[v - 1]) throw std::runtime_error("Corrupted snapshot: decreasing CSR offsets");
+    }
+
+    int vertices() const { return static_cast<int>(header.vertices); }
+    bool directed() const { return (header.flags & SNAPSHOT_DIRECTED) != 0; }
+    std::span<const Edge> edges() const { return section<Edge>(SnapshotLayout(header).edges, header.edges); }
+
+    bool verify() const {
+        SnapshotLayout layout(header);
+        uint64_t sum = SNAPSHOT_CHECKSUM_SEED;
+        sum = snapshotChecksum(sum, offsets().data(), offsets().size_bytes());
+        sum = snapshotChecksum(sum, file->data() + layout.targets, header.arcs * sizeof(int32_t));
+        sum = snapshotChecksum(sum, file->data() + layout.weights, header.arcs * sizeof(int32_t));
+        sum = snapshotChecksum(sum, edges().data(), edges().size_bytes());
+        return sum == header.checksum;
+    }
+
+    // CSR bez kopiowania, jesli skierowanie zgadza sie z zapisanym; inaczej budowany z listy krawedzi
+    CSRGraph csr(bool asDirected) const {
+        if (asDirected != directed()) {
+            checkEdges();
+            return CSRGraph(vertices(), asDirected, edges());
+        }
+        SnapshotLayout layout(header);
+        std::span<const int> targets = section<int>(layout.targets, header.arcs);
+        for (int t : targets)
+            if (t < 0 || t >= vertices()) throw std::runtime_error("Corrupted snapshot: vertex id out of range");
+        return CSRGraph(vertices(), directed(), offsets(), targets, section<int>(layout.weights, header.arcs), file);
+    }
+
+    // Lista i macierz potrzebuja wlasnych struktur - kopiowana jest gotowa lista krawedzi, bez parsowania
+    Graph toGraph(bool asDirected, GraphRepresentation repr) const {
+        checkEdges();
+        std::span<const Edge> list = edges();
+        Graph g(vertices(), asDirected, repr);
+        g.setEdges(std::vector<Edge>(list.begin(), list.end()));
+        return g;
+    }
+
+private:
+    std::shared_ptr<MappedFile> file;
+    SnapshotHeader header;
+
+    template <typename T>
+    std::span<const T> section(size_t at, uint64_t count) const {
+        return { reinterpret_cast<const T*>(file->data() + at), static_cast<size_t>(count) };
+    }
+
+    void checkEdges() const {
+        for (const Edge& e : edges())
+            if (e.from < 0 || e.from >= vertices() || e.to < 0 || e.to >= vertices())
+                throw std::runtime_error("Corrupted snapshot: vertex id out of range");
+    }
+
+    std::span<const int> offsets() const {
+        return section<int>(SnapshotLayout(header).offsets, header.vertices + 1);
+    }
+};
+
+#endif // SNAPSHOT_H
@@ -4,18 +4,18 @@ Timer::Timer() { reset(); }
 
 void Timer::reset() {
     running = false;
-    begin = end = std::chrono::high_resolution_clock::now();
+    begin = end = std::chrono::steady_clock::now();
 }
 
 int Timer::start() {
     running = true;
-    begin = std::chrono::high_resolution_clock::now();
+    begin = std::chrono::steady_clock::now();
     return 0;
 }
 
 int Timer::stop() {
     if (running) {
-        end = std::chrono::high_resolution_clock::now();
+        end = std::chrono::steady_clock::now();
         running = false;
     }
     return 0;
@@ -23,4 +23,8 @@ int Timer::stop() {
 
 int Timer::result() {
     return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+}
+
+long long Timer::resultNs() {
+    return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
 }
\ No newline at end of file
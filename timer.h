@@ -10,9 +10,10 @@ public:
     int start();
     int stop();
     int result();
+    long long resultNs();
 private:
     bool running;
-    std::chrono::high_resolution_clock::time_point begin, end;
+    std::chrono::steady_clock::time_point begin, end;
 };
 
 #endif
@@ -0,0 +1,348 @@
+#ifndef TYPED_GRAPH_H
+#define TYPED_GRAPH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "algorithms.h"
+#include "disjointSet.h"
+
+// Graf CSR i algorytmy o typach dobranych do danych: Index - numery wierzcholkow i pozycje lukow,
+// Weight - wagi krawedzi, Distance - odleglosci i sumy wag. Luk u32/u8 zajmuje 5 bajtow zamiast 8,
+// wiec petle relaksacji czytaja mniej pamieci; szeroki Distance chroni sumy wag przed przepelnieniem.
+enum class GraphTypes {
+    INT,            // Graph/CSRGraph i GraphAlgorithms (int wszedzie)
+    AUTO,           // najwezsze z ponizszych, w ktorych mieszcza sie zakresy wczytanego grafu
+    U32_U8_U32,     // wagi 0..255, odleglosci do 2^32 - 2
+    U32_I32_I64,    // dowolne wagi int (rowniez ujemne), odleglosci 64-bitowe
+    U64_I64_I64     // numery 64-bitowe; wejscie z plikow i generatora zawsze miesci sie w u32
+};
+
+std::string graphTypesName(GraphTypes types) {
+    switch (types) {
+    case GraphTypes::INT: return "int";
+    case GraphTypes::AUTO: return "auto";
+    case GraphTypes::U32_U8_U32: return "u32/u8/u32";
+    case GraphTypes::U32_I32_I64: return "u32/i32/i64";
+    case GraphTypes::U64_I64_I64: return "u64/i64/i64";
+    }
+    return "?";
+}
+
+template <typename Index, typename Weight>
+struct BasicEdge {
+    Index from, to;
+    Weight weight;
+    bool operator<(const BasicEdge& other) const {
+        return weight < other.weight;
+    }
+};
+
+// Kopia CSRGraph w wezszych lub szerszych typach; wlasne wektory, bez widokow na snapshot
+template <typename Index, typename Weight>
+struct BasicCSRGraph {
+    Index vertices = 0;
+    bool directed = true;
+    std::vector<Index> offsets;
+    std::vector<Index> targets;
+    std::vector<Weight> weights;
+
+    explicit BasicCSRGraph(const CSRGraph& g) : vertices(static_cast<Index>(g.vertices)), directed(g.directed),
+        offsets(g.offsets.begin(), g.offsets.end()), targets(g.targets.begin(), g.targets.end()) {
+        weights.reserve(g.weights.size());
+        for (int w : g.weights) {
+            if (!std::in_range<Weight>(w)) throw std::invalid_argument("Edge weight " + std::to_string(w) + " does not fit the graph weight type");
+            weights.push_back(static_cast<Weight>(w));
+        }
+    }
+
+    Index arcCount() const { return offsets[vertices]; }
+};
+
+template <typename Index, typename Weight, typename Fn>
+void forEachNeighbor(const BasicCSRGraph<Index, Weight>& g, Index u, Fn&& fn) {
+    for (Index i = g.offsets[u]; i < g.offsets[u + 1]; ++i) fn(g.targets[i], g.weights[i]);
+}
+
+// Odpowiedniki algorytmow GraphAlgorithms dla BasicCSRGraph. Wartosci graniczne: INF - wierzcholek
+// nieosiagalny, NONE - brak poprzednika (najwieksze wartosci typow, dlatego zakres numerow i odleglosci
+// jest o jeden mniejszy od zakresu typu - sprawdza to graphTypesFit).
+template <typename Index, typename Weight, typename Distance>
+class BasicGraphAlgorithms {
+public:
+    static_assert(std::is_unsigned_v<Index>, "Index must be unsigned");
+    static_assert(sizeof(Distance) >= sizeof(Weight) && std::is_signed_v<Distance> >= std::is_signed_v<Weight>,
+        "Distance must hold every Weight");
+
+    using IndexType = Index;
+    using WeightType = Weight;
+    using DistanceType = Distance;
+    using CSR = BasicCSRGraph<Index, Weight>;
+    using TypedEdge = BasicEdge<Index, Weight>;
+    static constexpr Distance INF = std::numeric_limits<Distance>::max();
+    static constexpr Index NONE = std::numeric_limits<Index>::max();
+
+    struct Paths {
+        std::vector<Distance> dist;
+        std::vector<Index> prev;
+        bool negativeCycle = false;
+        std::vector<Index> cycle;   // ujemny cykl jak w BellmanFordResult (pierwszy wierzcholek powtorzony na koncu)
+    };
+
+    static std::vector<TypedEdge> primMST(const CSR& g);
+    static std::vector<TypedEdge> kruskalMST(const CSR& g);
+    static Paths dijkstra(const CSR& g, Index start);
+    static Paths bellmanFord(const CSR& g, Index start);
+
+    static Distance totalWeight(const std::vector<TypedEdge>& edges);
+
+private:
+    static std::vector<Index> predecessorCycle(const std::vector<Index>& prev);
+};
+
+// Prim z kopcem (klucz, wierzcholek) i leniwym usuwaniem; las rozpinajacy dla grafu niespojnego
+template <typename Index, typename Weight, typename Distance>
+std::vector<BasicEdge<Index, Weight>> BasicGraphAlgorithms<Index, Weight, Distance>::primMST(const CSR& g) {
+    const Index n = g.vertices;
+    std::vector<Weight> key(n, 0);   // znaczacy tylko dla wierzcholkow z poprzednikiem
+    std::vector<Index> parent(n, NONE);
+    std::vector<char> inTree(n, 0);
+    std::vector<TypedEdge> mst;
+    std::vector<std::pair<Weight, Index>> heap;
+    std::greater<std::pair<Weight, Index>> later;
+
+    for (Index root = 0; root < n; ++root) {
+        if (inTree[root]) continue;
+        key[root] = 0;
+        heap.emplace_back(Weight{ 0 }, root);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto [k, u] = heap.back();
+            heap.pop_back();
+            if (inTree[u] || k > key[u]) continue;
+            inTree[u] = 1;
+            if (parent[u] != NONE) mst.push_back({ parent[u], u, k });
+
+            forEachNeighbor(g, u, [&](Index v, Weight w) {
+                // bez poprzednika = jeszcze nieosiagniety; waga rowna maksimum typu tez moze trafic do drzewa
+                if (inTree[v] || (parent[v] != NONE && w >= key[v])) return;
+                key[v] = w;
+                parent[v] = u;
+                heap.emplace_back(w, v);
+                std::push_heap(heap.begin(), heap.end(), later);
+            });
+        }
+    }
+    return mst;
+}
+
+template <typename Index, typename Weight, typename Distance>
+std::vector<BasicEdge<Index, Weight>> BasicGraphAlgorithms<Index, Weight, Distance>::kruskalMST(const CSR& g) {
+    std::vector<TypedEdge> edges;
+    edges.reserve(g.directed ? g.arcCount() : g.arcCount() / 2);
+    for (Index u = 0; u < g.vertices; ++u) {
+        for (Index i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            Index v = g.targets[i];
+            if (g.directed || u < v) edges.push_back({ u, v, g.weights[i] });
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    BasicDisjointSet<Index> sets(g.vertices);
+    std::vector<TypedEdge> mst;
+    size_t target = g.vertices > 0 ? static_cast<size_t>(g.vertices) - 1 : 0;
+    mst.reserve(target);
+    for (const TypedEdge& e : edges) {
+        if (sets.unite(e.from, e.to)) {
+            mst.push_back(e);
+            if (mst.size() == target) break;
+        }
+    }
+    return mst;
+}
+
+template <typename Index, typename Weight, typename Distance>
+typename BasicGraphAlgorithms<Index, Weight, Distance>::Paths BasicGraphAlgorithms<Index, Weight, Distance>::dijkstra(const CSR& g, Index start) {
+    Paths r;
+    r.dist.assign(g.vertices, INF);
+    r.prev.assign(g.vertices, NONE);
+    r.dist[start] = 0;
+    std::vector<std::pair<Distance, Index>> heap{ { Distance{ 0 }, start } };
+    std::greater<std::pair<Distance, Index>> later;
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto [d, u] = heap.back();
+        heap.pop_back();
+        if (d > r.dist[u]) continue;
+        forEachNeighbor(g, u, [&](Index v, Weight w) {
+            Distance nd = d + static_cast<Distance>(w);
+            if (nd < r.dist[v]) {
+                r.dist[v] = nd;
+                r.prev[v] = u;
+                heap.emplace_back(nd, v);
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        });
+    }
+    return r;
+}
+
+// Przebiegi relaksacji jak GraphAlgorithms::bellmanFordPasses, z pominieciem wierzcholkow nieosiagnietych
+template <typename Index, typename Weight, typename Distance>
+typename BasicGraphAlgorithms<Index, Weight, Distance>::Paths BasicGraphAlgorithms<Index, Weight, Distance>::bellmanFord(const CSR& g, Index start) {
+    Paths r;
+    r.dist.assign(g.vertices, INF);
+    r.prev.assign(g.vertices, NONE);
+    r.dist[start] = 0;
+
+    bool changed = true;
+    for (Index pass = 1; pass <= g.vertices && changed; ++pass) {
+        changed = false;
+        for (Index u = 0; u < g.vertices; ++u) {
+            const Distance du = r.dist[u];
+            if (du == INF) continue;
+            forEachNeighbor(g, u, [&](Index v, Weight w) {
+                Distance nd = du + static_cast<Distance>(w);
+                if (nd < r.dist[v]) {
+                    r.dist[v] = nd;
+                    r.prev[v] = u;
+                    changed = true;
+                }
+            });
+        }
+    }
+    if (changed) {
+        r.negativeCycle = true;
+        r.cycle = predecessorCycle(r.prev);
+    }
+    return r;
+}
+
+// Jak GraphAlgorithms::predecessorCycle: pierwszy cykl w grafie poprzednikow
+template <typename Index, typename Weight, typename Distance>
+std::vector<Index> BasicGraphAlgorithms<Index, Weight, Distance>::predecessorCycle(const std::vector<Index>& prev) {
+    const Index n = static_cast<Index>(prev.size());
+    std::vector<Index> walk(n, NONE);  // numer przejscia, w ktorym odwiedzono wierzcholek
+    for (Index s = 0; s < n; ++s) {
+        if (walk[s] != NONE) continue;
+        Index v = s;
+        while (v != NONE && walk[v] == NONE) {
+            walk[v] = s;
+            v = prev[v];
+        }
+        if (v == NONE || walk[v] != s) continue;
+        std::vector<Index> cycle{ v };
+        for (Index u = prev[v]; u != v; u = prev[u]) cycle.push_back(u);
+        cycle.push_back(v);
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+    return {};
+}
+
+template <typename Index, typename Weight, typename Distance>
+Distance BasicGraphAlgorithms<Index, Weight, Distance>::totalWeight(const std::vector<TypedEdge>& edges) {
+    Distance sum = 0;
+    for (const TypedEdge& e : edges) sum += static_cast<Distance>(e.weight);
+    return sum;
+}
+
+// Zestawy typow z GraphTypes; definicje jawnych konkretyzacji w main.cpp
+extern template struct BasicCSRGraph<uint32_t, uint8_t>;
+extern template struct BasicCSRGraph<uint32_t, int32_t>;
+extern template struct BasicCSRGraph<uint64_t, int64_t>;
+extern template class BasicGraphAlgorithms<uint32_t, uint8_t, uint32_t>;
+extern template class BasicGraphAlgorithms<uint32_t, int32_t, int64_t>;
+extern template class BasicGraphAlgorithms<uint64_t, int64_t, int64_t>;
+
+// Czy graf o tylu wierzcholkach i lukach oraz wagach z zakresu weights miesci sie w typach: numery i pozycje
+// lukow w Index, wagi w Weight, a najdluzsza mozliwa suma (V - 1) wag - i najmniejsza przy wagach ujemnych -
+// w Distance bez wartosci INF
+template <typename Index, typename Weight, typename Distance>
+bool graphTypesFit(long long vertices, long long arcs, std::pair<int, int> weights) {
+    if (vertices >= static_cast<long double>(std::numeric_limits<Index>::max())) return false;
+    if (arcs > static_cast<long double>(std::numeric_limits<Index>::max())) return false;
+    if (!std::in_range<Weight>(weights.first) || !std::in_range<Weight>(weights.second)) return false;
+    long double path = static_cast<long double>(std::max(vertices - 1, 0LL));
+    return path * weights.second < static_cast<long double>(std::numeric_limits<Distance>::max())
+        && path * weights.first > static_cast<long double>(std::numeric_limits<Distance>::lowest());
+}
+
+// fn(std::type_identity<BasicGraphAlgorithms<...>>{}) dla konkretnych typow z types
+template <typename Fn>
+decltype(auto) dispatchGraphTypes(GraphTypes types, Fn&& fn) {
+    switch (types) {
+    case GraphTypes::U32_U8_U32: return fn(std::type_identity<BasicGraphAlgorithms<uint32_t, uint8_t, uint32_t>>{});
+    case GraphTypes::U32_I32_I64: return fn(std::type_identity<BasicGraphAlgorithms<uint32_t, int32_t, int64_t>>{});
+    case GraphTypes::U64_I64_I64: return fn(std::type_identity<BasicGraphAlgorithms<uint64_t, int64_t, int64_t>>{});
+    default: throw std::invalid_argument("Graph types must be resolved before dispatch: " + graphTypesName(types));
+    }
+}
+
+bool graphTypesFit(GraphTypes types, const CSRGraph& g) {
+    return dispatchGraphTypes(types, [&](auto tag) {
+        using A = typename decltype(tag)::type;
+        return graphTypesFit<typename A::IndexType, typename A::WeightType, typename A::DistanceType>(g.vertices, g.arcCount(), weightRange(g));
+    });
+}
+
+// AUTO - najwezsze typy mieszczace graf; typy podane wprost sa sprawdzane
+GraphTypes resolveGraphTypes(GraphTypes requested, const CSRGraph& g) {
+    if (requested == GraphTypes::INT) return requested;
+    if (requested != GraphTypes::AUTO) {
+        if (!graphTypesFit(requested, g)) throw std::invalid_argument("Graph does not fit types " + graphTypesName(requested));
+        return requested;
+    }
+    for (GraphTypes types : { GraphTypes::U32_U8_U32, GraphTypes::U32_I32_I64, GraphTypes::U64_I64_I64 })
+        if (graphTypesFit(types, g)) return types;
+    throw std::invalid_argument("Graph does not fit any supported types");
+}
+
+// Wyniki z powrotem w typach programu: numery i wagi pochodza z CSRGraph, wiec mieszcza sie w int,
+// odleglosci przechowywane sa jako long long (LLONG_MAX - nieosiagalny)
+struct WidePaths {
+    std::vector<long long> dist;
+    std::vector<int> prev;
+    bool negativeCycle = false;
+    std::vector<int> cycle;
+};
+
+std::vector<Edge> typedMST(const CSRGraph& g, GraphTypes types, GraphAlgorithmType alg) {
+    return dispatchGraphTypes(types, [&](auto tag) {
+        using A = typename decltype(tag)::type;
+        typename A::CSR typed(g);
+        std::vector<typename A::TypedEdge> mst = alg == GraphAlgorithmType::PRIM ? A::primMST(typed) : A::kruskalMST(typed);
+        std::vector<Edge> result;
+        result.reserve(mst.size());
+        for (const typename A::TypedEdge& e : mst)
+            result.push_back({ static_cast<int>(e.from), static_cast<int>(e.to), static_cast<int>(e.weight) });
+        return result;
+    });
+}
+
+WidePaths typedShortestPaths(const CSRGraph& g, GraphTypes types, GraphAlgorithmType alg, int start) {
+    return dispatchGraphTypes(types, [&](auto tag) {
+        using A = typename decltype(tag)::type;
+        typename A::CSR typed(g);
+        using Index = typename A::IndexType;
+        typename A::Paths paths = alg == GraphAlgorithmType::DIJKSTRA ? A::dijkstra(typed, static_cast<Index>(start))
+            : A::bellmanFord(typed, static_cast<Index>(start));
+        WidePaths result;
+        result.negativeCycle = paths.negativeCycle;
+        result.dist.reserve(paths.dist.size());
+        for (auto d : paths.dist) result.dist.push_back(d == A::INF ? std::numeric_limits<long long>::max() : static_cast<long long>(d));
+        result.prev.reserve(paths.prev.size());
+        for (Index p : paths.prev) result.prev.push_back(p == A::NONE ? -1 : static_cast<int>(p));
+        for (Index v : paths.cycle) result.cycle.push_back(static_cast<int>(v));
+        return result;
+    });
+}
+
+#endif // TYPED_GRAPH_H
@@ -0,0 +1,40 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Tablica z resetem w O(1): pozycja ma wartosc fill, dopoki nie zostanie zapisana w biezacej epoce.
+// Pamiec przydzielana jest tylko przy zmianie rozmiaru; pelne czyszczenie - raz na 2^32 resetow.
+template <typename T>
+class StampedArray {
+public:
+    void reset(size_t n, T value) {
+        fill = value;
+        if (values.size() != n || epoch == UINT32_MAX) {
+            values.assign(n, value);
+            stamps.assign(n, 0);
+            epoch = 1;
+            return;
+        }
+        ++epoch;
+    }
+
+    T get(size_t i) const { return stamps[i] == epoch ? values[i] : fill; }
+
+    void set(size_t i, T value) {
+        values[i] = value;
+        stamps[i] = epoch;
+    }
+
+    size_t size() const { return values.size(); }
+
+private:
+    std::vector<T> values;
+    std::vector<uint32_t> stamps;
+    uint32_t epoch = 0;
+    T fill{};
+};
+
+#endif // WORKSPACE_H